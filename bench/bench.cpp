@@ -0,0 +1,493 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "core/document.hpp"
+#include "core/exporter.hpp"
+#include "core/framemodel.hpp"
+#include "core/synthetic.hpp"
+#include "core/scheduler.hpp"
+
+// Qt include.
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QSysInfo>
+#include <QSemaphore>
+#include <QThread>
+
+// C++ include.
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#if defined( Q_OS_WIN )
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+namespace /* anonymous */ {
+
+//! \return Peak resident set size in bytes.
+qint64
+peakRss()
+{
+#if defined( Q_OS_WIN )
+	PROCESS_MEMORY_COUNTERS pmc;
+
+	if( GetProcessMemoryInfo( GetCurrentProcess(), &pmc, sizeof( pmc ) ) )
+		return static_cast< qint64 > ( pmc.PeakWorkingSetSize );
+
+	return 0;
+#else
+	struct rusage usage;
+
+	if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+	{
+#if defined( Q_OS_MACOS )
+		return static_cast< qint64 > ( usage.ru_maxrss );
+#else
+		return static_cast< qint64 > ( usage.ru_maxrss ) * 1024;
+#endif
+	}
+
+	return 0;
+#endif
+}
+
+
+//
+// Input
+//
+
+//! Generated input GIF.
+struct Input final {
+	//! Name.
+	QString m_name;
+	//! File.
+	QString m_fileName;
+	//! Size of frames.
+	QSize m_size;
+	//! Count of frames.
+	int m_frames = 0;
+}; // struct Input
+
+//! Generate synthetic GIF into \a in. \return Is GIF written? On error \a error is set.
+bool
+generate( const QTemporaryDir & dir, const QString & name, const SyntheticOptions & opts,
+	Input & in, QString & error )
+{
+	in.m_name = QStringLiteral( "%1-%2x%3x%4" ).arg( name ).arg( opts.m_size.width() )
+		.arg( opts.m_size.height() ).arg( opts.m_frames );
+	in.m_fileName = dir.filePath( in.m_name + QStringLiteral( ".gif" ) );
+	in.m_size = opts.m_size;
+	in.m_frames = opts.m_frames;
+
+	if( !writeSyntheticGif( in.m_fileName, opts, &error ) )
+	{
+		if( error.isEmpty() )
+			error = QStringLiteral( "Unable to write \"%1\"." ).arg( in.m_fileName );
+
+		return false;
+	}
+
+	return true;
+}
+
+
+//
+// Result
+//
+
+//! Result of the benchmark.
+struct Result final {
+	//! Case.
+	QString m_case;
+	//! Input.
+	QString m_input;
+	//! Count of processed frames in one run.
+	qint64 m_frames = 0;
+	//! Count of processed pixels in one run.
+	qint64 m_pixels = 0;
+	//! Median wall time in nanoseconds.
+	qint64 m_nsecs = 0;
+	//! Peak RSS in bytes after the case.
+	qint64 m_peakRss = 0;
+}; // struct Result
+
+//! Run \a func \a repeats times. \return Result with median time.
+template< typename Func >
+Result
+measure( const QString & name, const Input & in, qint64 frames, qint64 pixels,
+	int repeats, Func func )
+{
+	std::vector< qint64 > times;
+	times.reserve( static_cast< size_t > ( repeats ) );
+
+	for( int i = 0; i < repeats; ++i )
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		func();
+
+		times.push_back( timer.nsecsElapsed() );
+	}
+
+	std::sort( times.begin(), times.end() );
+
+	Result r;
+	r.m_case = name;
+	r.m_input = in.m_name;
+	r.m_frames = frames;
+	r.m_pixels = pixels;
+	r.m_nsecs = times.at( times.size() / 2 );
+	r.m_peakRss = peakRss();
+
+	return r;
+}
+
+/*!
+	\return Result with the worst latency of interactive tasks posted
+	while \a frames of \a doc are written to \a fileName.
+*/
+Result
+interactiveLatency( const QString & name, const Input & in, const Document & doc,
+	const QVector< qsizetype > & frames, const QString & fileName, int repeats )
+{
+	auto & scheduler = Scheduler::instance();
+	std::vector< qint64 > worst;
+	qint64 samples = 0;
+
+	for( int i = 0; i < repeats; ++i )
+	{
+		std::atomic< bool > written( false );
+
+		scheduler.post( Scheduler::Priority::Background,
+			[&] ()
+			{
+				Exporter exporter;
+				exporter.write( doc, frames, fileName );
+
+				written = true;
+			} );
+
+		qint64 max = 0;
+
+		while( !written )
+		{
+			QSemaphore started;
+			QElapsedTimer timer;
+			timer.start();
+
+			scheduler.post( Scheduler::Priority::Interactive, [&started] () { started.release(); } );
+
+			started.acquire();
+
+			max = qMax( max, timer.nsecsElapsed() );
+			++samples;
+
+			QThread::msleep( 5 );
+		}
+
+		scheduler.waitForDone();
+
+		worst.push_back( max );
+	}
+
+	std::sort( worst.begin(), worst.end() );
+
+	Result r;
+	r.m_case = name;
+	r.m_input = in.m_name;
+	r.m_frames = samples / repeats;
+	r.m_nsecs = worst.at( worst.size() / 2 );
+	r.m_peakRss = peakRss();
+
+	return r;
+}
+
+//! \return Result as JSON.
+QJsonObject
+toJson( const Result & r )
+{
+	const double secs = (double) r.m_nsecs / 1000000000.0;
+
+	QJsonObject o;
+	o.insert( QStringLiteral( "case" ), r.m_case );
+	o.insert( QStringLiteral( "input" ), r.m_input );
+	o.insert( QStringLiteral( "frames" ), r.m_frames );
+	o.insert( QStringLiteral( "pixels" ), r.m_pixels );
+	o.insert( QStringLiteral( "wall_ms" ), (double) r.m_nsecs / 1000000.0 );
+	o.insert( QStringLiteral( "mp_per_s" ), secs > 0.0 ? (double) r.m_pixels / 1000000.0 / secs : 0.0 );
+	o.insert( QStringLiteral( "frames_per_s" ), secs > 0.0 ? (double) r.m_frames / secs : 0.0 );
+	o.insert( QStringLiteral( "peak_rss_bytes" ), r.m_peakRss );
+
+	return o;
+}
+
+//! Run all cases on the input. \return Is input loaded? On error \a error is set.
+bool
+runCases( const Input & in, int repeats, QVector< Result > & results, QString & error )
+{
+	const qint64 framePixels = static_cast< qint64 > ( in.m_size.width() ) * in.m_size.height();
+	const qint64 allPixels = framePixels * in.m_frames;
+
+	Document doc;
+
+	// Cases on empty document would time nothing.
+	if( !doc.load( in.m_fileName ) || !doc.count() )
+	{
+		error = QStringLiteral( "Unable to load \"%1\"." ).arg( in.m_fileName );
+
+		return false;
+	}
+
+	results.push_back( measure( QStringLiteral( "load" ), in, in.m_frames, allPixels, repeats,
+		[&] () { doc.load( in.m_fileName ); } ) );
+
+	// Decode of random frames, cache is off to measure decoding.
+	const int accesses = qMax( 100, in.m_frames );
+	QVector< qsizetype > positions( accesses );
+	auto * rnd = QRandomGenerator::global();
+
+	for( auto & p : positions )
+		p = rnd->bounded( static_cast< int > ( doc.count() ) );
+
+	doc.frames().setCacheLimit( 0 );
+
+	results.push_back( measure( QStringLiteral( "at_random" ), in, accesses,
+		framePixels * accesses, repeats,
+		[&] ()
+		{
+			for( const auto & p : std::as_const( positions ) )
+				doc.frames().image( p );
+		} ) );
+
+	// The rest of the cases measure processing, not decoding.
+	doc.frames().setCacheLimit( allPixels * 4 * 2 );
+
+	for( qsizetype i = 0; i < doc.count(); ++i )
+		doc.frames().image( i );
+
+	const QSize thumbnail( qMax( 1, in.m_size.width() * 100 / in.m_size.height() ), 100 );
+
+	results.push_back( measure( QStringLiteral( "thumbnail" ), in, in.m_frames, allPixels, repeats,
+		[&] ()
+		{
+			for( qsizetype i = 0; i < doc.count(); ++i )
+				doc.image( i, thumbnail );
+		} ) );
+
+	doc.edits().append( EditOperation::crop( QRect( in.m_size.width() / 4, in.m_size.height() / 4,
+		in.m_size.width() / 2, in.m_size.height() / 2 ) ) );
+
+	results.push_back( measure( QStringLiteral( "crop" ), in, in.m_frames, allPixels, repeats,
+		[&] ()
+		{
+			for( qsizetype i = 0; i < doc.count(); ++i )
+				doc.image( i );
+		} ) );
+
+	doc.edits().clear();
+
+	// Every third frame unchecked, collect checked frames like save and playback do.
+	FrameModel model;
+	model.reset( QVector< int > ( in.m_frames, 100 ) );
+
+	for( int i = 0; i < model.count(); i += 3 )
+		model.setChecked( i, false );
+
+	QVector< qsizetype > selected;
+
+	results.push_back( measure( QStringLiteral( "select" ), in, in.m_frames, 0, repeats,
+		[&] () { selected = model.checkedIndices(); } ) );
+
+	QTemporaryDir out;
+	const auto outFile = out.filePath( QStringLiteral( "out.gif" ) );
+
+	results.push_back( measure( QStringLiteral( "write" ), in, selected.size(),
+		framePixels * selected.size(), repeats,
+		[&] ()
+		{
+			Exporter exporter;
+			exporter.write( doc, selected, outFile );
+		} ) );
+
+	// Frames are rendered while they are written, cache is off so every frame is decoded.
+	doc.edits().append( EditOperation::crop( QRect( 0, 0, in.m_size.width() / 2,
+		in.m_size.height() / 2 ) ) );
+	doc.frames().setCacheLimit( 0 );
+
+	results.push_back( interactiveLatency( QStringLiteral( "interactive_latency" ), in, doc,
+		selected, outFile, repeats ) );
+
+	doc.edits().clear();
+
+	return true;
+}
+
+} /* namespace anonymous */
+
+
+int main( int argc, char ** argv )
+{
+	QCoreApplication app( argc, argv );
+	QCoreApplication::setApplicationName( QStringLiteral( "gif-editor-bench" ) );
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		QStringLiteral( "Benchmarks of load, random access, thumbnail, crop, "
+			"selection, write and interactive latency during write of GIF editor." ) );
+	parser.addHelpOption();
+
+	QCommandLineOption json( QStringLiteral( "json" ),
+		QStringLiteral( "Write results as JSON to the file, \"-\" for stdout." ),
+		QStringLiteral( "file" ) );
+	parser.addOption( json );
+
+	QCommandLineOption repeats( QStringLiteral( "repeats" ),
+		QStringLiteral( "Count of runs of each case, median is reported." ),
+		QStringLiteral( "count" ), QStringLiteral( "3" ) );
+	parser.addOption( repeats );
+
+	QCommandLineOption quick( QStringLiteral( "quick" ),
+		QStringLiteral( "Run on small inputs only." ) );
+	parser.addOption( quick );
+
+	parser.process( app );
+
+	const int runs = qMax( 1, parser.value( repeats ).toInt() );
+
+	//! Screen recording, small changes.
+	const auto screen = [] ( const QSize & size, int frames )
+	{
+		SyntheticOptions opts;
+		opts.m_size = size;
+		opts.m_frames = frames;
+		opts.m_change = 0.01;
+		opts.m_transparency = true;
+
+		return opts;
+	};
+
+	//! Full-motion video, all pixels change.
+	const auto motion = [] ( const QSize & size, int frames )
+	{
+		SyntheticOptions opts;
+		opts.m_size = size;
+		opts.m_frames = frames;
+		opts.m_change = 1.0;
+		opts.m_localPalettes = true;
+
+		return opts;
+	};
+
+	QVector< QPair< QString, SyntheticOptions > > shapes = {
+		{ QStringLiteral( "screen" ), screen( QSize( 320, 240 ), 10 ) },
+		{ QStringLiteral( "screen" ), screen( QSize( 320, 240 ), 200 ) },
+		{ QStringLiteral( "motion" ), motion( QSize( 1280, 720 ), 50 ) } };
+
+	if( !parser.isSet( quick ) )
+	{
+		shapes.push_back( { QStringLiteral( "screen" ), screen( QSize( 1920, 1080 ), 100 ) } );
+		shapes.push_back( { QStringLiteral( "motion" ), motion( QSize( 1920, 1080 ), 100 ) } );
+	}
+
+	QTemporaryDir dir;
+	QVector< Result > results;
+
+	for( const auto & shape : std::as_const( shapes ) )
+	{
+		Input in;
+		QString error;
+
+		if( !generate( dir, shape.first, shape.second, in, error ) ||
+			!runCases( in, runs, results, error ) )
+		{
+			QTextStream( stderr ) << QStringLiteral( "%1: %2" ).arg( in.m_name, error ) << Qt::endl;
+
+			return 1;
+		}
+	}
+
+	const bool jsonToStdout = ( parser.isSet( json ) &&
+		parser.value( json ) == QStringLiteral( "-" ) );
+
+	QTextStream stream( stdout );
+
+	// Table goes to stderr when JSON is on stdout, so stdout stays machine-readable.
+	QTextStream table( jsonToStdout ? stderr : stdout );
+
+	for( const auto & r : std::as_const( results ) )
+	{
+		const auto o = toJson( r );
+
+		table << QStringLiteral( "%1 %2: %3 ms, %4 MP/s, %5 frames/s, peak RSS %6 MB" )
+			.arg( r.m_case, -10 )
+			.arg( r.m_input, -14 )
+			.arg( o.value( QStringLiteral( "wall_ms" ) ).toDouble(), 0, 'f', 2 )
+			.arg( o.value( QStringLiteral( "mp_per_s" ) ).toDouble(), 0, 'f', 1 )
+			.arg( o.value( QStringLiteral( "frames_per_s" ) ).toDouble(), 0, 'f', 1 )
+			.arg( r.m_peakRss / ( 1024 * 1024 ) ) << Qt::endl;
+	}
+
+	if( parser.isSet( json ) )
+	{
+		QJsonArray cases;
+
+		for( const auto & r : std::as_const( results ) )
+			cases.append( toJson( r ) );
+
+		QJsonObject root;
+		root.insert( QStringLiteral( "cpu" ), QSysInfo::currentCpuArchitecture() );
+		root.insert( QStringLiteral( "os" ), QSysInfo::prettyProductName() );
+		root.insert( QStringLiteral( "repeats" ), runs );
+		root.insert( QStringLiteral( "results" ), cases );
+
+		const auto data = QJsonDocument( root ).toJson();
+
+		if( jsonToStdout )
+			stream << data;
+		else
+		{
+			QFile file( parser.value( json ) );
+
+			if( !file.open( QIODevice::WriteOnly ) )
+				return 1;
+
+			file.write( data );
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "core/synthetic.hpp"
+
+// Qt include.
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+
+
+int main( int argc, char ** argv )
+{
+	QCoreApplication app( argc, argv );
+	QCoreApplication::setApplicationName( QStringLiteral( "gif-editor-gifgen" ) );
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		QStringLiteral( "Generator of reproducible synthetic GIFs for performance testing." ) );
+	parser.addHelpOption();
+	parser.addPositionalArgument( QStringLiteral( "output" ),
+		QStringLiteral( "Output GIF." ) );
+
+	QCommandLineOption size( QStringLiteral( "size" ),
+		QStringLiteral( "Size of canvas, WIDTHxHEIGHT." ),
+		QStringLiteral( "size" ), QStringLiteral( "320x240" ) );
+	parser.addOption( size );
+
+	QCommandLineOption frames( QStringLiteral( "frames" ),
+		QStringLiteral( "Count of frames." ),
+		QStringLiteral( "count" ), QStringLiteral( "10" ) );
+	parser.addOption( frames );
+
+	QCommandLineOption change( QStringLiteral( "change" ),
+		QStringLiteral( "Fraction of pixels changing per frame, 0 - 1." ),
+		QStringLiteral( "fraction" ), QStringLiteral( "0.1" ) );
+	parser.addOption( change );
+
+	QCommandLineOption palette( QStringLiteral( "palette" ),
+		QStringLiteral( "Count of colors in palette, 2 - 256." ),
+		QStringLiteral( "count" ), QStringLiteral( "256" ) );
+	parser.addOption( palette );
+
+	QCommandLineOption localPalettes( QStringLiteral( "local-palettes" ),
+		QStringLiteral( "Local color table in each frame." ) );
+	parser.addOption( localPalettes );
+
+	QCommandLineOption transparency( QStringLiteral( "transparency" ),
+		QStringLiteral( "Unchanged pixels are transparent." ) );
+	parser.addOption( transparency );
+
+	QCommandLineOption disposal( QStringLiteral( "disposal" ),
+		QStringLiteral( "Disposal method, 0 - 3." ),
+		QStringLiteral( "method" ), QStringLiteral( "1" ) );
+	parser.addOption( disposal );
+
+	QCommandLineOption interlace( QStringLiteral( "interlace" ),
+		QStringLiteral( "Interlaced frames." ) );
+	parser.addOption( interlace );
+
+	QCommandLineOption delay( QStringLiteral( "delay" ),
+		QStringLiteral( "Delay of frames in milliseconds." ),
+		QStringLiteral( "ms" ), QStringLiteral( "40" ) );
+	parser.addOption( delay );
+
+	QCommandLineOption seed( QStringLiteral( "seed" ),
+		QStringLiteral( "Seed of random generator." ),
+		QStringLiteral( "seed" ), QStringLiteral( "1" ) );
+	parser.addOption( seed );
+
+	parser.process( app );
+
+	QTextStream err( stderr );
+
+	if( parser.positionalArguments().size() != 1 )
+	{
+		err << QStringLiteral( "One output file is required." ) << Qt::endl;
+
+		return 1;
+	}
+
+	const auto wh = parser.value( size ).split( QLatin1Char( 'x' ) );
+
+	if( wh.size() != 2 )
+	{
+		err << QStringLiteral( "Wrong size: %1." ).arg( parser.value( size ) ) << Qt::endl;
+
+		return 1;
+	}
+
+	SyntheticOptions opts;
+	opts.m_size = QSize( wh.at( 0 ).toInt(), wh.at( 1 ).toInt() );
+	opts.m_frames = parser.value( frames ).toInt();
+	opts.m_change = parser.value( change ).toDouble();
+	opts.m_paletteSize = parser.value( palette ).toInt();
+	opts.m_localPalettes = parser.isSet( localPalettes );
+	opts.m_transparency = parser.isSet( transparency );
+	opts.m_disposal = parser.value( disposal ).toInt();
+	opts.m_interlace = parser.isSet( interlace );
+	opts.m_delay = parser.value( delay ).toInt();
+	opts.m_seed = parser.value( seed ).toUInt();
+
+	QString error;
+
+	if( !writeSyntheticGif( parser.positionalArguments().constFirst(), opts, &error ) )
+	{
+		err << error << Qt::endl;
+
+		return 1;
+	}
+
+	return 0;
+}
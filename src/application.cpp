@@ -0,0 +1,127 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// GIF editor include.
+#include "application.hpp"
+#include "core/watchdog.hpp"
+
+// Qt include.
+#include <QAbstractEventDispatcher>
+#include <QThread>
+
+
+class ApplicationPrivate;
+
+namespace /* anonymous */ {
+
+//! Private data of the application, it's used by notify() that may be called
+//! before construction and after destruction of Application.
+ApplicationPrivate * s_private = nullptr;
+
+} /* namespace anonymous */
+
+
+//
+// ApplicationPrivate
+//
+
+class ApplicationPrivate {
+public:
+	ApplicationPrivate( Application * parent )
+		:	m_thread( QThread::currentThread() )
+		,	q( parent )
+	{
+	}
+
+	//! Init.
+	void init();
+
+	//! Watchdog of GUI thread.
+	Watchdog m_watchdog;
+	//! GUI thread.
+	QThread * m_thread;
+	//! Parent.
+	Application * q;
+}; // class ApplicationPrivate
+
+void
+ApplicationPrivate::init()
+{
+	auto * dispatcher = QAbstractEventDispatcher::instance( m_thread );
+
+	if( dispatcher )
+	{
+		Application::connect( dispatcher, &QAbstractEventDispatcher::aboutToBlock, q,
+			[this] () { m_watchdog.idle(); } );
+		Application::connect( dispatcher, &QAbstractEventDispatcher::awake, q,
+			[this] () { m_watchdog.awake(); } );
+	}
+}
+
+
+//
+// Application
+//
+
+Application::Application( int & argc, char ** argv )
+	:	QApplication( argc, argv )
+	,	d( new ApplicationPrivate( this ) )
+{
+	d->init();
+
+	s_private = d.data();
+}
+
+Application::~Application() noexcept
+{
+	s_private = nullptr;
+
+	const auto summary = Watchdog::summary();
+
+	if( !summary.isEmpty() )
+		qInfo( "%s", qPrintable( summary ) );
+}
+
+void
+Application::setStallThreshold( qint64 msecs )
+{
+	d->m_watchdog.setThreshold( msecs );
+}
+
+bool
+Application::notify( QObject * receiver, QEvent * event )
+{
+	// Null while QApplication is constructed or destroyed.
+	auto * that = s_private;
+
+	if( !that || QThread::currentThread() != that->m_thread )
+		return QApplication::notify( receiver, event );
+
+	that->m_watchdog.enter( receiver, event );
+
+	const bool result = QApplication::notify( receiver, event );
+
+	that->m_watchdog.leave();
+
+	return result;
+}
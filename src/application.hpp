@@ -0,0 +1,64 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_APPLICATION_HPP_INCLUDED
+#define GIF_EDITOR_APPLICATION_HPP_INCLUDED
+
+// Qt include.
+#include <QApplication>
+#include <QScopedPointer>
+
+
+//
+// Application
+//
+
+class ApplicationPrivate;
+
+/*!
+	Application that times every dispatch of event on GUI thread
+	and reports stalls of the event loop.
+*/
+class Application final
+	:	public QApplication
+{
+	Q_OBJECT
+
+public:
+	Application( int & argc, char ** argv );
+	~Application() noexcept override;
+
+	//! Set threshold of stalls in milliseconds, 0 disables the watchdog.
+	void setStallThreshold( qint64 msecs );
+
+	bool notify( QObject * receiver, QEvent * event ) override;
+
+private:
+	friend class ApplicationPrivate;
+
+	Q_DISABLE_COPY( Application )
+
+	QScopedPointer< ApplicationPrivate > d;
+}; // class Application
+
+#endif // GIF_EDITOR_APPLICATION_HPP_INCLUDED
@@ -54,6 +54,7 @@ public:
 	QColor color;
 	bool running;
 	bool showPercent = false;
+	QString details;
 	QVariantAnimation * animation;
 	BusyIndicator * q;
 }; // class BusyIndicatorPrivate
@@ -188,6 +189,23 @@ BusyIndicator::setShowPercent( bool on )
 	}
 }
 
+const QString &
+BusyIndicator::details() const
+{
+	return d->details;
+}
+
+void
+BusyIndicator::setDetails( const QString & text )
+{
+	if( d->details != text )
+	{
+		d->details = text;
+
+		update();
+	}
+}
+
 QSize
 BusyIndicator::minimumSizeHint() const
 {
@@ -238,6 +256,15 @@ BusyIndicator::paintEvent( QPaintEvent * )
 			QString( "%1%2" ).arg( QString::number( d->percent ),
 				QStringLiteral( "%" ) ) );
 	}
+
+	if( !d->details.isEmpty() )
+	{
+		p.setPen( palette().color( QPalette::WindowText ) );
+		p.setFont( font() );
+		p.drawText( QRect( -width() / 2, d->outerRadius + fontMetrics().height(),
+				width(), fontMetrics().height() * 2 ),
+			Qt::AlignHCenter | Qt::AlignTop, d->details );
+	}
 }
 
 void
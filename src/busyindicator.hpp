@@ -84,6 +84,12 @@ class BusyIndicator
 		\brief show percents in the center?
 	*/
 	Q_PROPERTY( bool showPercent READ showPercent WRITE setShowPercent )
+	/*!
+		\property details
+
+		\brief text displayed under the indicator
+	*/
+	Q_PROPERTY( QString details READ details WRITE setDetails )
 
 public:
 	BusyIndicator( QWidget * parent = nullptr );
@@ -114,6 +120,11 @@ public:
 	//! Set show percents in the center.
 	void setShowPercent( bool on = true );
 
+	//! \return Text under the indicator.
+	const QString & details() const;
+	//! Set text under the indicator.
+	void setDetails( const QString & text );
+
 	QSize minimumSizeHint() const override;
 	QSize sizeHint() const override;
 
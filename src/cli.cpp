@@ -0,0 +1,293 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "cli.hpp"
+#include "core/scheduler.hpp"
+
+// Qt include.
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QRect>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QThread>
+#include <QElapsedTimer>
+
+// C++ include.
+#include <cstring>
+#include <algorithm>
+
+
+namespace /* anonymous */ {
+
+//! \return Translated string.
+inline QString
+tr( const char * s )
+{
+	return QCoreApplication::translate( "Cli", s );
+}
+
+//! Print error.
+void
+printError( const QString & msg )
+{
+	QTextStream err( stderr );
+	err << msg << Qt::endl;
+}
+
+//! Parse crop rectangle in "x,y,w,h" format.
+bool
+parseRect( const QString & s, QRect & r )
+{
+	const auto parts = s.split( QLatin1Char( ',' ) );
+
+	if( parts.size() != 4 )
+		return false;
+
+	int v[ 4 ];
+
+	for( int i = 0; i < 4; ++i )
+	{
+		bool ok = false;
+		v[ i ] = parts.at( i ).trimmed().toInt( &ok );
+
+		if( !ok )
+			return false;
+	}
+
+	r = QRect( v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ] );
+
+	return ( r.width() > 0 && r.height() > 0 );
+}
+
+//! \return Input GIFs, directories and "@list" files are expanded.
+QStringList
+expandInputs( const QStringList & args )
+{
+	QStringList inputs;
+
+	for( const auto & arg : args )
+	{
+		if( arg.startsWith( QLatin1Char( '@' ) ) )
+		{
+			QFile list( arg.mid( 1 ) );
+
+			if( list.open( QIODevice::ReadOnly | QIODevice::Text ) )
+			{
+				QTextStream stream( &list );
+
+				while( !stream.atEnd() )
+				{
+					const auto line = stream.readLine().trimmed();
+
+					if( !line.isEmpty() && !line.startsWith( QLatin1Char( '#' ) ) )
+						inputs.push_back( line );
+				}
+			}
+			else
+				inputs.push_back( arg );
+		}
+		else if( QFileInfo( arg ).isDir() )
+		{
+			const auto files = QDir( arg ).entryInfoList( { QStringLiteral( "*.gif" ) },
+				QDir::Files, QDir::Name | QDir::IgnoreCase );
+
+			for( const auto & f : files )
+				inputs.push_back( f.absoluteFilePath() );
+		}
+		else
+			inputs.push_back( arg );
+	}
+
+	return inputs;
+}
+
+} /* namespace anonymous */
+
+
+bool
+isHeadless( int argc, char ** argv )
+{
+	static const char * options[] = { "--headless", "--out", "-o", "--crop", "-c",
+		"--drop", "-d", "--out-dir", "--join", "--jobs", "-j", "--memory-limit", "--help", "-h" };
+
+	for( int i = 1; i < argc; ++i )
+	{
+		for( const auto & o : options )
+		{
+			if( std::strcmp( argv[ i ], o ) == 0 ||
+				( std::strncmp( argv[ i ], o, std::strlen( o ) ) == 0 &&
+					argv[ i ][ std::strlen( o ) ] == '=' ) )
+						return true;
+		}
+	}
+
+	return false;
+}
+
+int
+runHeadless( int argc, char ** argv )
+{
+	QCoreApplication app( argc, argv );
+	QCoreApplication::setApplicationName( QStringLiteral( "gif-editor" ) );
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription( tr( "GIF editor. Headless mode." ) );
+	const auto help = parser.addHelpOption();
+
+	QCommandLineOption headless( QStringLiteral( "headless" ),
+		tr( "Run without GUI." ) );
+	parser.addOption( headless );
+
+	QCommandLineOption crop( { QStringLiteral( "c" ), QStringLiteral( "crop" ) },
+		tr( "Crop frames to the rectangle." ), QStringLiteral( "x,y,w,h" ) );
+	parser.addOption( crop );
+
+	QCommandLineOption drop( { QStringLiteral( "d" ), QStringLiteral( "drop" ) },
+		tr( "Drop frames, numbers start from 1, for example 1-10,50." ),
+		QStringLiteral( "frames" ) );
+	parser.addOption( drop );
+
+	QCommandLineOption out( { QStringLiteral( "o" ), QStringLiteral( "out" ) },
+		tr( "Output GIF." ), QStringLiteral( "file" ) );
+	parser.addOption( out );
+
+	QCommandLineOption outDir( QStringLiteral( "out-dir" ),
+		tr( "Output directory for batch processing, outputs have names of inputs." ),
+		QStringLiteral( "dir" ) );
+	parser.addOption( outDir );
+
+	QCommandLineOption join( QStringLiteral( "join" ),
+		tr( "Join inputs one after another into the output GIF." ) );
+	parser.addOption( join );
+
+	QCommandLineOption jobs( { QStringLiteral( "j" ), QStringLiteral( "jobs" ) },
+		tr( "Count of GIFs processed concurrently." ), QStringLiteral( "count" ),
+		QString::number( QThread::idealThreadCount() ) );
+	parser.addOption( jobs );
+
+	QCommandLineOption memoryLimit( QStringLiteral( "memory-limit" ),
+		tr( "Limit of memory of concurrently processed GIFs, in megabytes." ),
+		QStringLiteral( "MB" ), QStringLiteral( "0" ) );
+	parser.addOption( memoryLimit );
+
+	QCommandLineOption threads( QStringLiteral( "threads" ),
+		tr( "Count of worker threads, 0 is the count of cores." ),
+		QStringLiteral( "count" ), QStringLiteral( "0" ) );
+	parser.addOption( threads );
+
+	QCommandLineOption trace( QStringLiteral( "trace" ),
+		tr( "Write Chrome trace of operations to the file." ), QStringLiteral( "file" ) );
+	parser.addOption( trace );
+
+	parser.addPositionalArgument( QStringLiteral( "input" ),
+		tr( "Input GIFs, directories with GIFs or @file with list of GIFs." ),
+		QStringLiteral( "input..." ) );
+
+	if( !parser.parse( QCoreApplication::arguments() ) )
+	{
+		printError( parser.errorText() );
+
+		return static_cast< int > ( ExitCode::InvalidArguments );
+	}
+
+	if( parser.isSet( help ) )
+		parser.showHelp( static_cast< int > ( ExitCode::Ok ) );
+
+	Scheduler::setDefaultThreadCount( qMax( 0, parser.value( threads ).toInt() ) );
+
+	const auto inputs = expandInputs( parser.positionalArguments() );
+
+	if( inputs.isEmpty() || ( !parser.isSet( out ) && !parser.isSet( outDir ) ) ||
+		( inputs.size() > 1 && !parser.isSet( outDir ) && !parser.isSet( join ) ) ||
+		( parser.isSet( join ) && !parser.isSet( out ) ) )
+	{
+		printError( tr( "Input GIF and output file, inputs and output directory, "
+			"or inputs to join and output file should be given." ) );
+
+		return static_cast< int > ( ExitCode::InvalidArguments );
+	}
+
+	ProcessOptions opts;
+
+	if( parser.isSet( crop ) && !parseRect( parser.value( crop ), opts.m_crop ) )
+	{
+		printError( tr( "Wrong crop rectangle: %1" ).arg( parser.value( crop ) ) );
+
+		return static_cast< int > ( ExitCode::InvalidArguments );
+	}
+
+	opts.m_drop = parser.value( drop );
+
+	if( parser.isSet( join ) || !parser.isSet( outDir ) )
+	{
+		const auto r = joinGifs( inputs, parser.value( out ), opts );
+
+		if( r.m_code != ExitCode::Ok )
+			printError( r.m_error );
+
+		return static_cast< int > ( r.m_code );
+	}
+
+	bool jobsOk = false, memoryOk = false;
+	const auto jobsCount = parser.value( jobs ).toInt( &jobsOk );
+	const auto memoryMb = parser.value( memoryLimit ).toLongLong( &memoryOk );
+
+	if( !jobsOk || jobsCount < 1 || !memoryOk || memoryMb < 0 )
+	{
+		printError( tr( "Wrong count of jobs or memory limit." ) );
+
+		return static_cast< int > ( ExitCode::InvalidArguments );
+	}
+
+	const QDir dir( parser.value( outDir ) );
+
+	if( !dir.exists() && !QDir().mkpath( dir.absolutePath() ) )
+	{
+		printError( tr( "Unable to create directory: %1" ).arg( parser.value( outDir ) ) );
+
+		return static_cast< int > ( ExitCode::WriteFailed );
+	}
+
+	QVector< BatchTask > tasks;
+	tasks.reserve( inputs.size() );
+
+	for( const auto & input : inputs )
+		tasks.push_back( { input, dir.filePath( QFileInfo( input ).fileName() ) } );
+
+	QElapsedTimer timer;
+	timer.start();
+
+	BatchScheduler scheduler( jobsCount, memoryMb * 1024 * 1024 );
+	const auto results = scheduler.run( tasks, opts );
+
+	QTextStream stream( stdout );
+	printSummary( stream, results, timer.elapsed() );
+
+	const bool failed = std::any_of( results.cbegin(), results.cend(),
+		[] ( const ProcessResult & r ) { return r.m_code != ExitCode::Ok; } );
+
+	return static_cast< int > ( failed ? ExitCode::BatchFailed : ExitCode::Ok );
+}
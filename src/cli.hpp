@@ -0,0 +1,36 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CLI_HPP_INCLUDED
+#define GIF_EDITOR_CLI_HPP_INCLUDED
+
+// GIF editor include.
+#include "core/batch.hpp"
+
+
+//! \return Should application run without GUI?
+bool isHeadless( int argc, char ** argv );
+
+//! Run without GUI. \return Exit code.
+int runHeadless( int argc, char ** argv );
+
+#endif // GIF_EDITOR_CLI_HPP_INCLUDED
@@ -0,0 +1,314 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "batch.hpp"
+#include "document.hpp"
+#include "exporter.hpp"
+#include "trace.hpp"
+#include "scheduler.hpp"
+
+// Qt include.
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QFile>
+#include <QFileInfo>
+
+// C++ include.
+#include <algorithm>
+#include <limits>
+
+
+namespace /* anonymous */ {
+
+//! \return Translated string.
+inline QString
+tr( const char * s )
+{
+	return QCoreApplication::translate( "Batch", s );
+}
+
+/*!
+	Parse list of 1-based frames and ranges, like "1-10,50", and
+	mark them in \a marks.
+*/
+bool
+parseFrames( const QString & s, QVector< bool > & marks )
+{
+	for( const auto & part : s.split( QLatin1Char( ',' ), Qt::SkipEmptyParts ) )
+	{
+		const auto range = part.split( QLatin1Char( '-' ) );
+		bool ok1 = false, ok2 = false;
+		int first = 0, last = 0;
+
+		if( range.size() == 1 )
+		{
+			first = range.at( 0 ).trimmed().toInt( &ok1 );
+			last = first;
+			ok2 = true;
+		}
+		else if( range.size() == 2 )
+		{
+			first = range.at( 0 ).trimmed().toInt( &ok1 );
+			last = range.at( 1 ).trimmed().toInt( &ok2 );
+		}
+
+		if( !ok1 || !ok2 || first < 1 || last < first || last > marks.size() )
+			return false;
+
+		for( int i = first; i <= last; ++i )
+			marks[ i - 1 ] = true;
+	}
+
+	return true;
+}
+
+//! \return Megapixels per second.
+inline double
+megapixelsPerSecond( qint64 pixels, qint64 msecs )
+{
+	return ( msecs > 0 ? (double) pixels / 1000.0 / (double) msecs : 0.0 );
+}
+
+//! \return Frames per second.
+inline double
+framesPerSecond( qint64 frames, qint64 msecs )
+{
+	return ( msecs > 0 ? (double) frames * 1000.0 / (double) msecs : 0.0 );
+}
+
+} /* namespace anonymous */
+
+
+ProcessResult
+processGif( const QString & input, const QString & output, const ProcessOptions & opts )
+{
+	return joinGifs( { input }, output, opts );
+}
+
+ProcessResult
+joinGifs( const QStringList & inputs, const QString & output, const ProcessOptions & opts )
+{
+	TRACE_SPAN( "process" );
+
+	const auto input = inputs.join( QStringLiteral( " + " ) );
+
+	ProcessResult r;
+	r.m_input = input;
+	r.m_output = output;
+
+	QElapsedTimer timer;
+	timer.start();
+
+	auto fail = [&r, &timer] ( ExitCode code, const QString & msg )
+	{
+		r.m_code = code;
+		r.m_error = msg;
+		r.m_msecs = timer.elapsed();
+
+		return r;
+	};
+
+	Document doc;
+
+	for( const auto & file : inputs )
+	{
+		if( !( doc.count() ? doc.append( file ) : doc.load( file ) ) )
+			return fail( ExitCode::LoadFailed, tr( "Unable to read GIF: %1" ).arg( file ) );
+	}
+
+	if( doc.count() == 0 )
+		return fail( ExitCode::LoadFailed, tr( "Unable to read GIF: %1" ).arg( input ) );
+
+	const QRect full( QPoint( 0, 0 ), doc.frames().size() );
+
+	r.m_frames = doc.count();
+	r.m_pixels = static_cast< qint64 > ( full.width() ) * full.height() * r.m_frames;
+
+	if( !opts.m_crop.isNull() )
+	{
+		if( !full.contains( opts.m_crop ) )
+			return fail( ExitCode::InvalidCrop,
+				tr( "Crop rectangle is out of the image %1x%2: %3" )
+					.arg( full.width() ).arg( full.height() ).arg( input ) );
+
+		doc.edits().append( EditOperation::crop( opts.m_crop ) );
+	}
+
+	QVector< bool > dropped( doc.count(), false );
+
+	if( !parseFrames( opts.m_drop, dropped ) )
+		return fail( ExitCode::InvalidArguments,
+			tr( "Wrong frames to drop: %1" ).arg( opts.m_drop ) );
+
+	QVector< qsizetype > toSave;
+
+	for( qsizetype i = 0; i < doc.count(); ++i )
+	{
+		if( !dropped.at( i ) )
+			toSave.push_back( i );
+	}
+
+	if( toSave.isEmpty() )
+		return fail( ExitCode::NoFrames, tr( "All frames were dropped: %1" ).arg( input ) );
+
+	Exporter exporter;
+
+	if( !exporter.write( doc, toSave, output ) )
+		return fail( ExitCode::WriteFailed, tr( "Unable to write GIF: %1" ).arg( output ) );
+
+	r.m_msecs = timer.elapsed();
+
+	return r;
+}
+
+void
+printSummary( QTextStream & stream, const QVector< ProcessResult > & results,
+	qint64 wallMsecs )
+{
+	qint64 frames = 0;
+	qint64 pixels = 0;
+	int failed = 0;
+
+	for( const auto & r : results )
+	{
+		stream << r.m_input << QStringLiteral( ": " );
+
+		if( r.m_code == ExitCode::Ok )
+		{
+			stream << tr( "%1 frames, %2 MP, %3 s, %4 MP/s, %5 fps" )
+				.arg( r.m_frames )
+				.arg( (double) r.m_pixels / 1000000.0, 0, 'f', 1 )
+				.arg( (double) r.m_msecs / 1000.0, 0, 'f', 2 )
+				.arg( megapixelsPerSecond( r.m_pixels, r.m_msecs ), 0, 'f', 1 )
+				.arg( framesPerSecond( r.m_frames, r.m_msecs ), 0, 'f', 1 );
+
+			frames += r.m_frames;
+			pixels += r.m_pixels;
+		}
+		else
+		{
+			stream << r.m_error;
+
+			++failed;
+		}
+
+		stream << Qt::endl;
+	}
+
+	stream << tr( "Total: %1 files, %2 failed, %3 frames, %4 MP, %5 s, %6 MP/s, %7 fps" )
+		.arg( results.size() )
+		.arg( failed )
+		.arg( frames )
+		.arg( (double) pixels / 1000000.0, 0, 'f', 1 )
+		.arg( (double) wallMsecs / 1000.0, 0, 'f', 2 )
+		.arg( megapixelsPerSecond( pixels, wallMsecs ), 0, 'f', 1 )
+		.arg( framesPerSecond( frames, wallMsecs ), 0, 'f', 1 ) << Qt::endl;
+}
+
+
+//
+// BatchScheduler
+//
+
+BatchScheduler::BatchScheduler( int jobs, qint64 memoryLimit )
+	:	m_jobs( qMax( 1, jobs ) )
+	,	m_memoryLimit( qMax( Q_INT64_C( 0 ), memoryLimit ) )
+{
+}
+
+qint64
+BatchScheduler::estimateMemory( const QString & fileName )
+{
+	QFile file( fileName );
+
+	if( file.open( QIODevice::ReadOnly ) )
+	{
+		// Logical screen size follows "GIF89a" signature.
+		const auto header = file.read( 10 );
+
+		if( header.size() == 10 && header.startsWith( "GIF" ) )
+		{
+			const auto * h = reinterpret_cast< const uchar* > ( header.constData() );
+			const qint64 width = h[ 6 ] | ( h[ 7 ] << 8 );
+			const qint64 height = h[ 8 ] | ( h[ 9 ] << 8 );
+
+			// Frame being decoded, frames being rendered and frame being encoded.
+			return width * height * 4 * ( Scheduler::instance().threadCount() + 2 );
+		}
+	}
+
+	return QFileInfo( fileName ).size() * 4;
+}
+
+QVector< ProcessResult >
+BatchScheduler::run( const QVector< BatchTask > & tasks, const ProcessOptions & opts )
+{
+	QVector< ProcessResult > results( tasks.size() );
+	QVector< qint64 > costs( tasks.size() );
+	QVector< int > order( tasks.size() );
+
+	for( int i = 0; i < tasks.size(); ++i )
+	{
+		costs[ i ] = estimateMemory( tasks.at( i ).m_input );
+		order[ i ] = i;
+	}
+
+	// Biggest first, so a big GIF doesn't keep one core busy alone in the end.
+	std::stable_sort( order.begin(), order.end(),
+		[&costs] ( int i1, int i2 ) { return costs.at( i1 ) > costs.at( i2 ); } );
+
+	// Memory is counted in KiB to fit into semaphore.
+	const int limit = static_cast< int > ( qMin( m_memoryLimit / 1024,
+		static_cast< qint64 > ( std::numeric_limits< int >::max() ) ) );
+
+	QSemaphore jobs( m_jobs );
+	QSemaphore memory( limit );
+	QSemaphore finished;
+	auto * out = results.data();
+
+	for( const auto i : std::as_const( order ) )
+	{
+		// GIF bigger than the limit runs alone.
+		const int cost = ( limit > 0 ?
+			static_cast< int > ( qBound( Q_INT64_C( 1 ), costs.at( i ) / 1024,
+				static_cast< qint64 > ( limit ) ) ) : 0 );
+
+		jobs.acquire();
+		memory.acquire( cost );
+
+		Scheduler::instance().post( Scheduler::Priority::Background,
+			[&tasks, &opts, &jobs, &memory, &finished, out, i, cost] ()
+			{
+				out[ i ] = processGif( tasks.at( i ).m_input, tasks.at( i ).m_output, opts );
+
+				memory.release( cost );
+				jobs.release();
+				finished.release();
+			} );
+	}
+
+	finished.acquire( static_cast< int > ( tasks.size() ) );
+
+	return results;
+}
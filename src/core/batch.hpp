@@ -0,0 +1,153 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_BATCH_HPP_INCLUDED
+#define GIF_EDITOR_CORE_BATCH_HPP_INCLUDED
+
+// Qt include.
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QTextStream>
+
+
+//! Exit codes of headless processing.
+enum class ExitCode : int {
+	//! Success.
+	Ok = 0,
+	//! Wrong command line arguments.
+	InvalidArguments = 1,
+	//! Input GIF can't be read.
+	LoadFailed = 2,
+	//! Crop rectangle is out of the image.
+	InvalidCrop = 3,
+	//! All frames were dropped.
+	NoFrames = 4,
+	//! Output GIF can't be written.
+	WriteFailed = 5,
+	//! Some GIFs of the batch weren't processed.
+	BatchFailed = 6
+}; // enum class ExitCode
+
+
+//
+// ProcessOptions
+//
+
+//! Options of processing of GIF.
+struct ProcessOptions final {
+	//! Crop rectangle, null if frames shouldn't be cropped.
+	QRect m_crop;
+	//! Frames to drop, numbers start from 1, for example 1-10,50.
+	QString m_drop;
+}; // struct ProcessOptions
+
+
+//
+// ProcessResult
+//
+
+//! Result of processing of GIF.
+struct ProcessResult final {
+	//! Input file.
+	QString m_input;
+	//! Output file.
+	QString m_output;
+	//! Exit code.
+	ExitCode m_code = ExitCode::Ok;
+	//! Error message.
+	QString m_error;
+	//! Count of decoded frames.
+	qint64 m_frames = 0;
+	//! Count of decoded pixels.
+	qint64 m_pixels = 0;
+	//! Duration in milliseconds.
+	qint64 m_msecs = 0;
+}; // struct ProcessResult
+
+//! Load, edit and save one GIF.
+ProcessResult processGif( const QString & input, const QString & output,
+	const ProcessOptions & opts );
+
+/*!
+	Join GIFs one after another, edit and save them as one GIF.
+
+	Inputs are decoded one by one, frames of another size are placed
+	on canvas of the first GIF.
+*/
+ProcessResult joinGifs( const QStringList & inputs, const QString & output,
+	const ProcessOptions & opts );
+
+//! Print per-file and aggregate throughput.
+void printSummary( QTextStream & stream, const QVector< ProcessResult > & results,
+	qint64 wallMsecs );
+
+
+//
+// BatchTask
+//
+
+//! Task of batch.
+struct BatchTask final {
+	//! Input file.
+	QString m_input;
+	//! Output file.
+	QString m_output;
+}; // struct BatchTask
+
+
+//
+// BatchScheduler
+//
+
+/*!
+	Processes many GIFs concurrently.
+
+	Biggest GIFs are started first, count of concurrent GIFs is limited
+	by jobs count and estimated memory of running GIFs is limited by
+	the memory limit. Threads of the pool not occupied by GIFs help to
+	render frames of running GIFs, so one huge GIF uses all cores too.
+*/
+class BatchScheduler final {
+public:
+	/*!
+		\a jobs is maximum count of concurrently processed GIFs,
+		\a memoryLimit is in bytes, 0 means no limit.
+	*/
+	BatchScheduler( int jobs, qint64 memoryLimit );
+
+	//! Process tasks. \return Results in order of tasks.
+	QVector< ProcessResult > run( const QVector< BatchTask > & tasks,
+		const ProcessOptions & opts );
+
+	//! \return Estimated memory needed to process GIF.
+	static qint64 estimateMemory( const QString & fileName );
+
+private:
+	//! Maximum count of concurrent GIFs.
+	int m_jobs;
+	//! Memory limit in bytes.
+	qint64 m_memoryLimit;
+}; // class BatchScheduler
+
+#endif // GIF_EDITOR_CORE_BATCH_HPP_INCLUDED
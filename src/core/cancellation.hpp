@@ -0,0 +1,60 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_CANCELLATION_HPP_INCLUDED
+#define GIF_EDITOR_CORE_CANCELLATION_HPP_INCLUDED
+
+// C++ include.
+#include <atomic>
+#include <memory>
+
+
+//
+// CancellationToken
+//
+
+//! Cooperative cancellation flag, copies share the flag.
+class CancellationToken final {
+public:
+	CancellationToken()
+		:	m_flag( std::make_shared< std::atomic< bool > > ( false ) )
+	{
+	}
+
+	//! Request cancellation.
+	void cancel() const
+	{
+		m_flag->store( true, std::memory_order_relaxed );
+	}
+
+	//! \return Is cancellation requested?
+	bool isCancelled() const
+	{
+		return m_flag->load( std::memory_order_relaxed );
+	}
+
+private:
+	//! Flag.
+	std::shared_ptr< std::atomic< bool > > m_flag;
+}; // class CancellationToken
+
+#endif // GIF_EDITOR_CORE_CANCELLATION_HPP_INCLUDED
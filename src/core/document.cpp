@@ -0,0 +1,138 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "document.hpp"
+
+// C++ include.
+#include <utility>
+
+
+//
+// Document
+//
+
+Document::Document()
+{
+}
+
+Document::~Document()
+{
+}
+
+bool
+Document::load( const QString & fileName, const CancellationToken & token )
+{
+	clear();
+
+	m_fileName = fileName;
+
+	return m_frames.load( fileName, token );
+}
+
+bool
+Document::append( const QString & fileName, const CancellationToken & token )
+{
+	FrameStore other;
+
+	if( !other.load( fileName, token ) )
+		return false;
+
+	m_frames.append( other );
+
+	return true;
+}
+
+void
+Document::clear()
+{
+	m_frames.clear();
+	m_edits.clear();
+}
+
+void
+Document::swap( Document & other )
+{
+	m_fileName.swap( other.m_fileName );
+	m_frames.swap( other.m_frames );
+	std::swap( m_edits, other.m_edits );
+}
+
+const QString &
+Document::fileName() const
+{
+	return m_fileName;
+}
+
+void
+Document::setFileName( const QString & fileName )
+{
+	m_fileName = fileName;
+}
+
+FrameStore &
+Document::frames()
+{
+	return m_frames;
+}
+
+const FrameStore &
+Document::frames() const
+{
+	return m_frames;
+}
+
+EditStack &
+Document::edits()
+{
+	return m_edits;
+}
+
+const EditStack &
+Document::edits() const
+{
+	return m_edits;
+}
+
+qsizetype
+Document::count() const
+{
+	return m_frames.count();
+}
+
+QImage
+Document::image( qsizetype pos ) const
+{
+	return m_edits.render( m_frames.image( pos ) );
+}
+
+QImage
+Document::image( qsizetype pos, const QSize & size ) const
+{
+	return m_edits.render( m_frames.image( pos ), size );
+}
+
+QSize
+Document::imageSize() const
+{
+	return m_edits.resultSize( m_frames.size() );
+}
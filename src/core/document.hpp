@@ -0,0 +1,95 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_DOCUMENT_HPP_INCLUDED
+#define GIF_EDITOR_CORE_DOCUMENT_HPP_INCLUDED
+
+// Qt include.
+#include <QImage>
+#include <QString>
+
+// GIF editor include.
+#include "framestore.hpp"
+#include "edits.hpp"
+
+
+//
+// Document
+//
+
+//! Opened GIF: decoded frames and edits of them.
+class Document final {
+public:
+	Document();
+	~Document();
+
+	//! Load GIF. \return Is GIF loaded and not cancelled?
+	bool load( const QString & fileName,
+		const CancellationToken & token = CancellationToken() );
+	/*!
+		Append GIF, frames of another size are placed on canvas of the
+		document, it's the size of the first GIF. \return Is GIF loaded
+		and not cancelled?
+	*/
+	bool append( const QString & fileName,
+		const CancellationToken & token = CancellationToken() );
+	//! Clear.
+	void clear();
+	//! Swap with other document.
+	void swap( Document & other );
+
+	//! \return File name.
+	const QString & fileName() const;
+	//! Set file name.
+	void setFileName( const QString & fileName );
+
+	//! \return Frames.
+	FrameStore & frames();
+	//! \return Frames.
+	const FrameStore & frames() const;
+
+	//! \return Edits.
+	EditStack & edits();
+	//! \return Edits.
+	const EditStack & edits() const;
+
+	//! \return Count of frames.
+	qsizetype count() const;
+	//! \return Edited frame in full resolution.
+	QImage image( qsizetype pos ) const;
+	//! \return Edited frame scaled to the given size.
+	QImage image( qsizetype pos, const QSize & size ) const;
+	//! \return Size of edited frames.
+	QSize imageSize() const;
+
+private:
+	Q_DISABLE_COPY( Document )
+
+	//! File name.
+	QString m_fileName;
+	//! Frames.
+	FrameStore m_frames;
+	//! Edits.
+	EditStack m_edits;
+}; // class Document
+
+#endif // GIF_EDITOR_CORE_DOCUMENT_HPP_INCLUDED
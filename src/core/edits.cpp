@@ -0,0 +1,329 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "edits.hpp"
+#include "trace.hpp"
+
+// C++ include.
+#include <algorithm>
+#include <cstring>
+
+
+//
+// EditOperation
+//
+
+EditOperation
+EditOperation::crop( const QRect & r )
+{
+	EditOperation op;
+	op.m_type = Type::Crop;
+	op.m_rect = r;
+
+	return op;
+}
+
+EditOperation
+EditOperation::scale( const QSize & s )
+{
+	EditOperation op;
+	op.m_type = Type::Scale;
+	op.m_size = s;
+
+	return op;
+}
+
+EditOperation
+EditOperation::simple( Type t )
+{
+	EditOperation op;
+	op.m_type = t;
+
+	return op;
+}
+
+bool
+operator == ( const EditOperation & o1, const EditOperation & o2 )
+{
+	return ( o1.m_type == o2.m_type && o1.m_rect == o2.m_rect && o1.m_size == o2.m_size );
+}
+
+bool
+operator != ( const EditOperation & o1, const EditOperation & o2 )
+{
+	return !( o1 == o2 );
+}
+
+
+//
+// EditPlan
+//
+
+bool
+EditPlan::isIdentity( const QSize & sourceSize ) const
+{
+	return ( m_source == QRect( QPoint( 0, 0 ), sourceSize ) && m_size == sourceSize &&
+		!m_flipHorizontally && !m_flipVertically && m_colorOps.isEmpty() );
+}
+
+
+namespace /* anonymous */ {
+
+//! \return Color with applied color operations.
+inline QRgb
+applyColorOps( QRgb c, const QVector< EditOperation::Type > & ops, bool premultiplied )
+{
+	for( const auto & op : ops )
+	{
+		switch( op )
+		{
+			case EditOperation::Type::Grayscale :
+			{
+				const int g = qGray( c );
+				c = qRgba( g, g, g, qAlpha( c ) );
+			}
+				break;
+
+			case EditOperation::Type::Invert :
+			{
+				const int max = ( premultiplied ? qAlpha( c ) : 255 );
+				c = qRgba( max - qRed( c ), max - qGreen( c ), max - qBlue( c ), qAlpha( c ) );
+			}
+				break;
+
+			default :
+				break;
+		}
+	}
+
+	return c;
+}
+
+//! Copy pixels with mirroring and color operations in one pass.
+void
+transfer( const QImage & from, QImage & to, const EditPlan & plan )
+{
+	const bool premultiplied = ( to.format() == QImage::Format_ARGB32_Premultiplied );
+	const int w = to.width();
+	const int h = to.height();
+
+	for( int y = 0; y < h; ++y )
+	{
+		const auto * in = reinterpret_cast< const QRgb* > (
+			from.constScanLine( plan.m_flipVertically ? h - 1 - y : y ) );
+		auto * out = reinterpret_cast< QRgb* > ( to.scanLine( y ) );
+
+		if( plan.m_colorOps.isEmpty() )
+		{
+			if( plan.m_flipHorizontally )
+				std::reverse_copy( in, in + w, out );
+			else
+				std::memcpy( out, in, static_cast< size_t > ( w ) * sizeof( QRgb ) );
+		}
+		else if( plan.m_flipHorizontally )
+		{
+			for( int x = 0; x < w; ++x )
+				out[ x ] = applyColorOps( in[ w - 1 - x ], plan.m_colorOps, premultiplied );
+		}
+		else
+		{
+			for( int x = 0; x < w; ++x )
+				out[ x ] = applyColorOps( in[ x ], plan.m_colorOps, premultiplied );
+		}
+	}
+}
+
+} /* namespace anonymous */
+
+
+//
+// EditStack
+//
+
+bool
+EditStack::isEmpty() const
+{
+	return m_ops.isEmpty();
+}
+
+int
+EditStack::count() const
+{
+	return m_ops.count();
+}
+
+const QVector< EditOperation > &
+EditStack::operations() const
+{
+	return m_ops;
+}
+
+void
+EditStack::append( const EditOperation & op )
+{
+	m_ops.append( op );
+}
+
+void
+EditStack::clear()
+{
+	m_ops.clear();
+}
+
+EditPlan
+EditStack::plan( const QSize & sourceSize ) const
+{
+	EditPlan p;
+	p.m_source = QRect( QPoint( 0, 0 ), sourceSize );
+	p.m_size = sourceSize;
+
+	for( const auto & op : std::as_const( m_ops ) )
+	{
+		switch( op.m_type )
+		{
+			case EditOperation::Type::Crop :
+			{
+				const auto r = op.m_rect.intersected( QRect( QPoint( 0, 0 ), p.m_size ) );
+
+				if( r.isEmpty() )
+					break;
+
+				// Crop is in the coordinates of the mirrored and scaled result,
+				// map it back to the source.
+				const double sx = (double) p.m_source.width() / (double) p.m_size.width();
+				const double sy = (double) p.m_source.height() / (double) p.m_size.height();
+				const int x = ( p.m_flipHorizontally ?
+					p.m_size.width() - r.x() - r.width() : r.x() );
+				const int y = ( p.m_flipVertically ?
+					p.m_size.height() - r.y() - r.height() : r.y() );
+
+				const QRect source( p.m_source.x() + qRound( x * sx ),
+					p.m_source.y() + qRound( y * sy ),
+					qMax( 1, qRound( r.width() * sx ) ),
+					qMax( 1, qRound( r.height() * sy ) ) );
+
+				p.m_source = source.intersected( p.m_source );
+				p.m_size = r.size();
+			}
+				break;
+
+			case EditOperation::Type::Scale :
+			{
+				if( !op.m_size.isEmpty() )
+					p.m_size = op.m_size;
+			}
+				break;
+
+			case EditOperation::Type::FlipHorizontally :
+				p.m_flipHorizontally = !p.m_flipHorizontally;
+				break;
+
+			case EditOperation::Type::FlipVertically :
+				p.m_flipVertically = !p.m_flipVertically;
+				break;
+
+			case EditOperation::Type::Grayscale :
+			case EditOperation::Type::Invert :
+				p.m_colorOps.append( op.m_type );
+				break;
+		}
+	}
+
+	return p;
+}
+
+QSize
+EditStack::resultSize( const QSize & sourceSize ) const
+{
+	return plan( sourceSize ).m_size;
+}
+
+QImage
+EditStack::render( const QImage & source ) const
+{
+	return render( source, resultSize( source.size() ) );
+}
+
+QImage
+EditStack::render( const QImage & source, const QSize & size ) const
+{
+	if( source.isNull() || size.isEmpty() )
+		return {};
+
+	TRACE_SPAN( "render" );
+
+	const auto p = plan( source.size() );
+
+	if( p.isIdentity( source.size() ) && size == source.size() )
+		return source;
+
+	QImage img = source;
+
+	if( img.format() != QImage::Format_ARGB32 &&
+		img.format() != QImage::Format_ARGB32_Premultiplied &&
+		img.format() != QImage::Format_RGB32 )
+			img = img.convertToFormat( QImage::Format_ARGB32 );
+
+	// Source rectangle without copying of pixels.
+	const QImage view( img.constBits() + p.m_source.y() * img.bytesPerLine() +
+			p.m_source.x() * static_cast< qsizetype > ( sizeof( QRgb ) ),
+		p.m_source.width(), p.m_source.height(), img.bytesPerLine(), img.format() );
+
+	const bool pixelOps = ( p.m_flipHorizontally || p.m_flipVertically ||
+		!p.m_colorOps.isEmpty() );
+
+	if( size != view.size() )
+	{
+		const auto scaled = view.scaled( size, Qt::IgnoreAspectRatio,
+			Qt::SmoothTransformation );
+
+		if( !pixelOps )
+			return scaled;
+
+		QImage result( size, scaled.format() );
+		transfer( scaled, result, p );
+
+		return result;
+	}
+	else if( !pixelOps )
+		return view.copy();
+	else
+	{
+		QImage result( size, img.format() );
+		transfer( view, result, p );
+
+		return result;
+	}
+}
+
+bool
+operator == ( const EditStack & s1, const EditStack & s2 )
+{
+	return ( s1.m_ops == s2.m_ops );
+}
+
+bool
+operator != ( const EditStack & s1, const EditStack & s2 )
+{
+	return !( s1 == s2 );
+}
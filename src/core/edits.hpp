@@ -0,0 +1,150 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_EDITS_HPP_INCLUDED
+#define GIF_EDITOR_CORE_EDITS_HPP_INCLUDED
+
+// Qt include.
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+
+//
+// EditOperation
+//
+
+/*!
+	Edit operation. Geometry of the operation is in the coordinates
+	of the result of all previous operations in the stack.
+*/
+struct EditOperation final {
+	//! Type of the operation.
+	enum class Type {
+		//! Crop.
+		Crop,
+		//! Scale.
+		Scale,
+		//! Flip horizontally.
+		FlipHorizontally,
+		//! Flip vertically.
+		FlipVertically,
+		//! Convert to grayscale.
+		Grayscale,
+		//! Invert colors.
+		Invert
+	}; // enum class Type
+
+	//! \return Crop operation.
+	static EditOperation crop( const QRect & r );
+	//! \return Scale operation.
+	static EditOperation scale( const QSize & s );
+	//! \return Operation without parameters.
+	static EditOperation simple( Type t );
+
+	//! Type.
+	Type m_type = Type::Crop;
+	//! Crop rectangle.
+	QRect m_rect;
+	//! Size to scale to.
+	QSize m_size;
+}; // struct EditOperation
+
+bool operator == ( const EditOperation & o1, const EditOperation & o2 );
+bool operator != ( const EditOperation & o1, const EditOperation & o2 );
+
+
+//
+// EditPlan
+//
+
+/*!
+	Edit stack resolved against the size of the source image.
+	All geometric operations are folded into one source rectangle,
+	mirroring flags and the size of the result, so a frame is rendered
+	in one pass regardless of the count of operations.
+*/
+struct EditPlan final {
+	//! \return Is this plan do nothing?
+	bool isIdentity( const QSize & sourceSize ) const;
+
+	//! Rectangle of the source image to read from.
+	QRect m_source;
+	//! Size of the result.
+	QSize m_size;
+	//! Mirror horizontally.
+	bool m_flipHorizontally = false;
+	//! Mirror vertically.
+	bool m_flipVertically = false;
+	//! Color operations in order of applying.
+	QVector< EditOperation::Type > m_colorOps;
+}; // struct EditPlan
+
+
+//
+// EditStack
+//
+
+/*!
+	Non-destructive list of edit operations of the document.
+	Source frames are never changed, edits are applied on the fly
+	for previews and once in full resolution on export.
+
+	Copying of the stack is cheap, operations are implicitly shared.
+*/
+class EditStack final {
+public:
+	EditStack() = default;
+
+	//! \return Is stack empty?
+	bool isEmpty() const;
+	//! \return Count of operations.
+	int count() const;
+	//! \return Operations.
+	const QVector< EditOperation > & operations() const;
+	//! Append operation.
+	void append( const EditOperation & op );
+	//! Clear.
+	void clear();
+
+	//! \return Plan for the source image of the given size.
+	EditPlan plan( const QSize & sourceSize ) const;
+	//! \return Size of the result for the source image of the given size.
+	QSize resultSize( const QSize & sourceSize ) const;
+
+	//! \return Edited image in full resolution.
+	QImage render( const QImage & source ) const;
+	//! \return Edited image scaled to the given size.
+	QImage render( const QImage & source, const QSize & size ) const;
+
+	friend bool operator == ( const EditStack & s1, const EditStack & s2 );
+
+private:
+	//! Operations.
+	QVector< EditOperation > m_ops;
+}; // class EditStack
+
+bool operator == ( const EditStack & s1, const EditStack & s2 );
+bool operator != ( const EditStack & s1, const EditStack & s2 );
+
+#endif // GIF_EDITOR_CORE_EDITS_HPP_INCLUDED
@@ -0,0 +1,301 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "exporter.hpp"
+#include "document.hpp"
+#include "parallel.hpp"
+#include "trace.hpp"
+#include "metrics.hpp"
+#include "progress.hpp"
+#include "tempfiles.hpp"
+
+// Qt include.
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QHash>
+
+// qgiflib include.
+#include <qgiflib.hpp>
+
+// C++ include.
+#include <atomic>
+
+
+namespace /* anonymous */ {
+
+//! Write GIF with \a func to a temporary file and replace \a fileName with it.
+template< typename Func >
+bool
+writeReplacing( const QString & fileName, const CancellationToken & token, Func func )
+{
+	if( token.isCancelled() )
+		return false;
+
+	QString tmpName;
+
+	{
+		QTemporaryFile tmp( fileName + QStringLiteral( ".XXXXXX" ) );
+
+		if( !tmp.open() )
+			return false;
+
+		tmp.setAutoRemove( false );
+		tmpName = tmp.fileName();
+
+		// Removed on quit that doesn't wait for the write.
+		TemporaryFiles::add( tmpName );
+	}
+
+	const bool ok = func( tmpName ) && !token.isCancelled() &&
+		( !QFile::exists( fileName ) || QFile::remove( fileName ) ) &&
+		QFile::rename( tmpName, fileName );
+
+	if( !ok )
+		QFile::remove( tmpName );
+
+	TemporaryFiles::remove( tmpName );
+
+	return ok;
+}
+
+} /* namespace anonymous */
+
+
+//
+// Exporter
+//
+
+Exporter::Exporter( QObject * parent )
+	:	QObject( parent )
+{
+}
+
+Exporter::~Exporter() noexcept
+{
+}
+
+void
+Exporter::setProgress( Progress * progress )
+{
+	m_progress = progress;
+}
+
+bool
+Exporter::write( const Document & doc, const QVector< qsizetype > & frames,
+	const QString & fileName, const CancellationToken & token )
+{
+	QVector< FrameHandle > handles;
+	handles.reserve( frames.size() );
+
+	for( const auto & pos : frames )
+		handles.push_back( doc.frames().handle( pos ) );
+
+	return write( handles, doc.edits(), fileName, token );
+}
+
+bool
+Exporter::write( const QVector< FrameHandle > & frames, const EditStack & edits,
+	const QString & fileName, const CancellationToken & token )
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	const bool ok = writeFrames( frames, edits, fileName, token );
+
+	Metrics::set( Metrics::instance().m_lastSaveMsecs, timer.elapsed() );
+
+	return ok;
+}
+
+bool
+Exporter::writeFrames( const QVector< FrameHandle > & frames, const EditStack & edits,
+	const QString & fileName, const CancellationToken & token )
+{
+	QStringList files;
+	QVector< int > delays;
+	QSize canvas;
+	files.reserve( frames.size() );
+	delays.reserve( frames.size() );
+
+	for( const auto & h : frames )
+	{
+		files.push_back( h.m_fileName );
+		delays.push_back( h.m_delay );
+
+		// Frames of appended GIFs of another size have canvas of the document,
+		// it's the size of its first GIF, so any of them gives it whatever the order is.
+		Q_ASSERT( h.m_canvas.isEmpty() || canvas.isEmpty() || h.m_canvas == canvas );
+
+		if( canvas.isEmpty() )
+			canvas = h.m_canvas;
+	}
+
+	return write( files, delays, edits, fileName, token, canvas );
+}
+
+bool
+Exporter::write( const QVector< Segment > & segments, const EditStack & edits,
+	const CancellationToken & token )
+{
+	TRACE_SPAN( "write_segments" );
+
+	QElapsedTimer timer;
+	timer.start();
+
+	std::atomic< bool > ok( true );
+
+	if( m_progress )
+	{
+		qint64 total = 0;
+
+		for( const auto & s : segments )
+			total += s.m_frames.size();
+
+		// Progress of qgiflib is per file, frames of segment are counted when it's written.
+		m_progress->begin( Progress::Stage::Encoding, total );
+	}
+
+	// Decoded frames are composited, so the first frame of every segment is complete
+	// and segments don't depend on each other. Encoding in qgiflib holds its worker
+	// till the end, so one worker is left for interactive and thumbnail tasks.
+	const int count = static_cast< int > ( segments.size() );
+	const int lanes = qBound( 1, Scheduler::instance().threadCount() - 1, count );
+	std::atomic< int > next( 0 );
+
+	parallelFor( lanes,
+		[&] ( int )
+		{
+			for( int i = next++; i < count; i = next++ )
+			{
+				if( !ok || token.isCancelled() )
+					return;
+
+				Exporter exporter;
+
+				if( !exporter.writeFrames( segments.at( i ).m_frames, edits,
+					segments.at( i ).m_fileName, token ) )
+						ok = false;
+
+				if( m_progress )
+					m_progress->add( segments.at( i ).m_frames.size() );
+			}
+		} );
+
+	// Time of the whole split, not of the segment written last.
+	Metrics::set( Metrics::instance().m_lastSaveMsecs, timer.elapsed() );
+
+	return ( ok && !token.isCancelled() );
+}
+
+bool
+Exporter::write( const QStringList & files, const QVector< int > & delays,
+	const EditStack & edits, const QString & fileName, const CancellationToken & token,
+	const QSize & canvas )
+{
+	TRACE_SPAN( "write" );
+
+	QGifLib::Gif encoder;
+
+	const qint64 total = files.size();
+
+	// qgiflib reports percents only, they are converted to frames.
+	connect( &encoder, &QGifLib::Gif::writeProgress, this,
+		[this, total] ( int percent )
+		{
+			if( m_progress )
+				m_progress->setDone( total * percent / 100 );
+		}, Qt::DirectConnection );
+
+	// Quantization and encoding in qgiflib can't be interrupted,
+	// result of cancelled write is dropped.
+	auto encode = [&] ( const QStringList & frames )
+	{
+		if( m_progress )
+			m_progress->begin( Progress::Stage::Encoding, total );
+
+		return writeReplacing( fileName, token,
+			[&] ( const QString & tmpName )
+			{
+				TRACE_SPAN( "quantize_encode" );
+
+				return encoder.write( tmpName, frames, delays, 0 );
+			} );
+	};
+
+	if( edits.isEmpty() && canvas.isEmpty() )
+		return encode( files );
+
+	QTemporaryDir dir;
+
+	if( !dir.isValid() )
+		return false;
+
+	const TemporaryPath tmpDir( dir.path() );
+
+	// Frames repeated by reverse or ping-pong share the source file,
+	// each source is rendered once and all its repeats refer to the result.
+	QHash< QString, qsizetype > sources;
+	QStringList unique;
+	QStringList rendered;
+	rendered.reserve( files.size() );
+
+	for( const auto & file : files )
+	{
+		auto it = sources.constFind( file );
+
+		if( it == sources.cend() )
+		{
+			it = sources.insert( file, unique.size() );
+			unique.push_back( file );
+		}
+
+		rendered.push_back( dir.filePath( QStringLiteral( "%1.png" ).arg( it.value() ) ) );
+	}
+
+	std::atomic< bool > ok( true );
+
+	if( m_progress )
+		m_progress->begin( Progress::Stage::Rendering, unique.size() );
+
+	parallelFor( static_cast< int > ( unique.size() ),
+		[&] ( int i )
+		{
+			if( !ok || token.isCancelled() )
+				return;
+
+			if( !edits.render( placeOnCanvas( QImage( unique.at( i ) ), canvas ) ).save(
+				dir.filePath( QStringLiteral( "%1.png" ).arg( i ) ) ) )
+					ok = false;
+
+			if( m_progress )
+				m_progress->add();
+		} );
+
+	if( !ok || token.isCancelled() )
+		return false;
+
+	return encode( rendered );
+}
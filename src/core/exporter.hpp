@@ -0,0 +1,117 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_EXPORTER_HPP_INCLUDED
+#define GIF_EDITOR_CORE_EXPORTER_HPP_INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+// GIF editor include.
+#include "edits.hpp"
+#include "framestore.hpp"
+#include "cancellation.hpp"
+
+
+class Document;
+class Progress;
+
+
+//
+// Segment
+//
+
+//! Frames written to one file.
+struct Segment final {
+	//! Frames.
+	QVector< FrameHandle > m_frames;
+	//! File.
+	QString m_fileName;
+}; // struct Segment
+
+
+//
+// Exporter
+//
+
+/*!
+	Writes frames to GIF applying edits once per frame in full resolution.
+
+	GIF is written to a temporary file next to the target and replaces
+	the target only on success, so failed or cancelled write leaves
+	the target untouched.
+*/
+class Exporter final
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit Exporter( QObject * parent = nullptr );
+	~Exporter() noexcept override;
+
+	//! Set progress of rendering and encoding, it's not owned.
+	void setProgress( Progress * progress );
+
+	//! Write frames of the document at the given positions. \return Is written?
+	bool write( const Document & doc, const QVector< qsizetype > & frames,
+		const QString & fileName,
+		const CancellationToken & token = CancellationToken() );
+	/*!
+		Write frames applying edits, handles keep decoded GIFs alive
+		till the end of writing. \return Is written?
+	*/
+	bool write( const QVector< FrameHandle > & frames, const EditStack & edits,
+		const QString & fileName,
+		const CancellationToken & token = CancellationToken() );
+	/*!
+		Write decoded frames applying edits, frames are placed on \a canvas
+		if it's not empty. \return Is written?
+	*/
+	bool write( const QStringList & files, const QVector< int > & delays,
+		const EditStack & edits, const QString & fileName,
+		const CancellationToken & token = CancellationToken(),
+		const QSize & canvas = QSize() );
+	/*!
+		Write segments concurrently on all workers but one, so interactive
+		and thumbnail tasks always have a free worker. Idle workers help to
+		render frames of segments.
+		Progress counts frames of written segments. \return Are all segments written?
+	*/
+	bool write( const QVector< Segment > & segments, const EditStack & edits,
+		const CancellationToken & token = CancellationToken() );
+
+private:
+	//! Write frames without recording time of save.
+	bool writeFrames( const QVector< FrameHandle > & frames, const EditStack & edits,
+		const QString & fileName, const CancellationToken & token );
+
+private:
+	Q_DISABLE_COPY( Exporter )
+
+	//! Progress.
+	Progress * m_progress = nullptr;
+}; // class Exporter
+
+#endif // GIF_EDITOR_CORE_EXPORTER_HPP_INCLUDED
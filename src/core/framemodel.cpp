@@ -0,0 +1,506 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// GIF editor include.
+#include "framemodel.hpp"
+
+// Qt include.
+#include <QtAlgorithms>
+
+// C++ include.
+#include <algorithm>
+
+
+namespace /* anonymous */ {
+
+//! \return Mask of bits below \a bit.
+inline quint64
+lowBits( int bit )
+{
+	return ( Q_UINT64_C( 1 ) << bit ) - 1;
+}
+
+} /* namespace anonymous */
+
+
+//
+// FrameModel
+//
+
+FrameModel::FrameModel( QObject * parent )
+	:	QObject( parent )
+	,	m_count( 0 )
+	,	m_checked( 0 )
+	,	m_ranksDirty( false )
+{
+}
+
+FrameModel::~FrameModel() noexcept
+{
+}
+
+void
+FrameModel::reset( const QVector< int > & delays )
+{
+	m_count = static_cast< int > ( delays.size() );
+	m_checked = m_count;
+	m_delays = delays;
+	m_bits.assign( static_cast< size_t > ( ( m_count + 63 ) / 64 ), ~Q_UINT64_C( 0 ) );
+
+	if( m_count % 64 )
+		m_bits.back() = lowBits( m_count % 64 );
+
+	m_ranksDirty = true;
+
+	QVector< qint64 > durations;
+	durations.reserve( m_count );
+
+	for( int i = 0; i < m_count; ++i )
+		durations.push_back( timeOf( i ) );
+
+	m_timeline.reset( durations );
+}
+
+void
+FrameModel::clear()
+{
+	reset( {} );
+}
+
+void
+FrameModel::append( const QVector< int > & delays )
+{
+	const int first = m_count;
+
+	m_count += static_cast< int > ( delays.size() );
+	m_checked += static_cast< int > ( delays.size() );
+	m_delays.append( delays );
+	m_bits.resize( static_cast< size_t > ( ( m_count + 63 ) / 64 ), 0 );
+
+	for( int i = first; i < m_count; ++i )
+		m_bits[ i >> 6 ] |= ( Q_UINT64_C( 1 ) << ( i & 63 ) );
+
+	m_ranksDirty = true;
+
+	QVector< qint64 > durations;
+	durations.reserve( m_count );
+
+	for( int i = 0; i < m_count; ++i )
+		durations.push_back( timeOf( i ) );
+
+	m_timeline.reset( durations );
+}
+
+void
+FrameModel::removeUnchecked()
+{
+	if( m_checked == m_count )
+		return;
+
+	QVector< int > delays;
+	delays.reserve( m_checked );
+
+	for( const auto & idx : checkedIndices() )
+		delays.push_back( m_delays.at( idx ) );
+
+	reset( delays );
+}
+
+void
+FrameModel::move( int first, int count, int to )
+{
+	if( count <= 0 || first < 0 || first + count > m_count || to < 0 ||
+		to > m_count - count || to == first )
+			return;
+
+	const int lo = qMin( first, to );
+	const int hi = qMax( first, to ) + count;
+
+	std::vector< bool > checked( static_cast< size_t > ( hi - lo ) );
+
+	for( int i = lo; i < hi; ++i )
+		checked[ i - lo ] = isChecked( i );
+
+	// Moving to the left rotates the range to the right and vice versa.
+	const int shift = ( to < first ? first - lo : count );
+
+	std::rotate( m_delays.begin() + lo, m_delays.begin() + lo + shift, m_delays.begin() + hi );
+	std::rotate( checked.begin(), checked.begin() + shift, checked.end() );
+
+	for( int i = lo; i < hi; ++i )
+	{
+		const auto mask = Q_UINT64_C( 1 ) << ( i & 63 );
+
+		if( checked[ i - lo ] )
+			m_bits[ i >> 6 ] |= mask;
+		else
+			m_bits[ i >> 6 ] &= ~mask;
+
+		m_timeline.setDuration( i, timeOf( i ) );
+	}
+
+	m_ranksDirty = true;
+}
+
+void
+FrameModel::rearrange( const QVector< qsizetype > & order )
+{
+	QVector< int > delays;
+	delays.reserve( order.size() );
+
+	std::vector< quint64 > bits( static_cast< size_t > ( ( order.size() + 63 ) / 64 ), 0 );
+	int checked = 0;
+
+	for( qsizetype i = 0; i < order.size(); ++i )
+	{
+		const auto pos = static_cast< int > ( order.at( i ) );
+
+		delays.push_back( m_delays.at( pos ) );
+
+		if( isChecked( pos ) )
+		{
+			bits[ i >> 6 ] |= ( Q_UINT64_C( 1 ) << ( i & 63 ) );
+			++checked;
+		}
+	}
+
+	m_count = static_cast< int > ( order.size() );
+	m_checked = checked;
+	m_delays = std::move( delays );
+	m_bits = std::move( bits );
+	m_ranksDirty = true;
+
+	QVector< qint64 > durations;
+	durations.reserve( m_count );
+
+	for( int i = 0; i < m_count; ++i )
+		durations.push_back( timeOf( i ) );
+
+	m_timeline.reset( durations );
+}
+
+int
+FrameModel::count() const
+{
+	return m_count;
+}
+
+int
+FrameModel::delay( int idx ) const
+{
+	return m_delays.at( idx );
+}
+
+void
+FrameModel::setDelay( const QVector< qsizetype > & indices, int delay )
+{
+	bool changed = false;
+
+	for( const auto & i : indices )
+	{
+		const auto idx = static_cast< int > ( i );
+
+		if( idx >= 0 && idx < m_count && m_delays.at( idx ) != delay )
+		{
+			m_delays[ idx ] = delay;
+			changed = true;
+
+			if( isChecked( idx ) )
+				m_timeline.setDuration( idx, timeOf( idx ) );
+		}
+	}
+
+	if( changed )
+		emit delaysChanged();
+}
+
+qint64
+FrameModel::duration() const
+{
+	return m_timeline.total();
+}
+
+qint64
+FrameModel::startTime( int idx ) const
+{
+	return m_timeline.start( idx );
+}
+
+int
+FrameModel::frameAt( qint64 msecs ) const
+{
+	return m_timeline.at( msecs );
+}
+
+qint64
+FrameModel::timeOf( int idx ) const
+{
+	// The same clamping as in playback, so the timeline matches it.
+	return ( isChecked( idx ) ? qMax( m_delays.at( idx ), c_minFrameDelay ) : 0 );
+}
+
+bool
+FrameModel::isChecked( int idx ) const
+{
+	return ( m_bits[ idx >> 6 ] >> ( idx & 63 ) ) & 1;
+}
+
+void
+FrameModel::setChecked( int idx, bool on )
+{
+	if( idx < 0 || idx >= m_count || isChecked( idx ) == on )
+		return;
+
+	m_bits[ idx >> 6 ] ^= ( Q_UINT64_C( 1 ) << ( idx & 63 ) );
+	m_checked += ( on ? 1 : -1 );
+	m_ranksDirty = true;
+	m_timeline.setDuration( idx, timeOf( idx ) );
+
+	emit checkedChanged( idx, idx );
+}
+
+void
+FrameModel::setChecked( int first, int last, bool on )
+{
+	first = qMax( 0, first );
+	last = qMin( last, m_count - 1 );
+
+	if( first > last )
+		return;
+
+	auto bits = m_bits;
+	const int firstWord = first >> 6;
+	const int lastWord = last >> 6;
+
+	for( int word = firstWord; word <= lastWord; ++word )
+	{
+		quint64 mask = ~Q_UINT64_C( 0 );
+
+		if( word == firstWord )
+			mask &= ~lowBits( first & 63 );
+
+		if( word == lastWord && ( last & 63 ) != 63 )
+			mask &= lowBits( ( last & 63 ) + 1 );
+
+		if( on )
+			bits[ word ] |= mask;
+		else
+			bits[ word ] &= ~mask;
+	}
+
+	assign( std::move( bits ) );
+}
+
+void
+FrameModel::checkEveryNth( int n, int offset )
+{
+	if( n < 1 )
+		return;
+
+	offset = ( ( offset % n ) + n ) % n;
+
+	setCheckedIf( [n, offset] ( int idx ) { return idx % n == offset; } );
+}
+
+void
+FrameModel::invert()
+{
+	auto bits = m_bits;
+
+	for( auto & word : bits )
+		word = ~word;
+
+	if( m_count % 64 )
+		bits.back() &= lowBits( m_count % 64 );
+
+	assign( std::move( bits ) );
+}
+
+void
+FrameModel::checkByDelay( int minDelay, int maxDelay )
+{
+	setCheckedIf( [this, minDelay, maxDelay] ( int idx )
+		{
+			const auto delay = m_delays.at( idx );
+
+			return ( delay >= minDelay && delay <= maxDelay );
+		} );
+}
+
+void
+FrameModel::setCheckedIf( const std::function< bool ( int ) > & pred )
+{
+	std::vector< quint64 > bits( m_bits.size(), 0 );
+
+	for( int i = 0; i < m_count; ++i )
+	{
+		if( pred( i ) )
+			bits[ i >> 6 ] |= ( Q_UINT64_C( 1 ) << ( i & 63 ) );
+	}
+
+	assign( std::move( bits ) );
+}
+
+void
+FrameModel::assign( std::vector< quint64 > && bits )
+{
+	int first = -1;
+	int last = -1;
+
+	for( size_t word = 0; word < bits.size(); ++word )
+	{
+		const auto diff = bits[ word ] ^ m_bits[ word ];
+
+		if( diff )
+		{
+			if( first < 0 )
+				first = static_cast< int > ( word * 64 + qCountTrailingZeroBits( diff ) );
+
+			last = static_cast< int > ( word * 64 + 63 - qCountLeadingZeroBits( diff ) );
+
+			m_checked += qPopulationCount( bits[ word ] ) - qPopulationCount( m_bits[ word ] );
+		}
+	}
+
+	if( first < 0 )
+		return;
+
+	std::swap( m_bits, bits );
+	m_ranksDirty = true;
+
+	// Old flags are in bits now, only changed frames are updated on the timeline.
+	for( size_t word = first >> 6; word <= static_cast< size_t > ( last >> 6 ); ++word )
+	{
+		for( auto diff = bits[ word ] ^ m_bits[ word ]; diff; diff &= diff - 1 )
+		{
+			const auto idx = static_cast< int > ( word * 64 + qCountTrailingZeroBits( diff ) );
+
+			m_timeline.setDuration( idx, timeOf( idx ) );
+		}
+	}
+
+	emit checkedChanged( first, last );
+}
+
+int
+FrameModel::checkedCount() const
+{
+	return m_checked;
+}
+
+void
+FrameModel::updateRanks() const
+{
+	if( !m_ranksDirty )
+		return;
+
+	m_ranks.resize( m_bits.size() );
+
+	int r = 0;
+
+	for( size_t i = 0; i < m_bits.size(); ++i )
+	{
+		m_ranks[ i ] = r;
+		r += qPopulationCount( m_bits[ i ] );
+	}
+
+	m_ranksDirty = false;
+}
+
+int
+FrameModel::rank( int idx ) const
+{
+	if( idx <= 0 )
+		return 0;
+
+	if( idx >= m_count )
+		return m_checked;
+
+	updateRanks();
+
+	return m_ranks[ idx >> 6 ] + qPopulationCount( m_bits[ idx >> 6 ] & lowBits( idx & 63 ) );
+}
+
+int
+FrameModel::select( int n ) const
+{
+	if( n < 0 || n >= m_checked )
+		return -1;
+
+	updateRanks();
+
+	// The last word with less than n + 1 checked frames before it.
+	const auto it = std::upper_bound( m_ranks.cbegin(), m_ranks.cend(), n ) - 1;
+	const auto word = static_cast< int > ( it - m_ranks.cbegin() );
+	auto bits = m_bits[ word ];
+
+	for( int skip = n - *it; skip > 0; --skip )
+		bits &= bits - 1;
+
+	return word * 64 + static_cast< int > ( qCountTrailingZeroBits( bits ) );
+}
+
+int
+FrameModel::nextChecked( int idx, bool wrap ) const
+{
+	if( !m_checked )
+		return -1;
+
+	if( idx < 0 )
+		idx = 0;
+
+	if( idx < m_count )
+	{
+		auto word = idx >> 6;
+		auto bits = m_bits[ word ] & ~lowBits( idx & 63 );
+
+		while( true )
+		{
+			if( bits )
+				return word * 64 + static_cast< int > ( qCountTrailingZeroBits( bits ) );
+
+			if( ++word == static_cast< int > ( m_bits.size() ) )
+				break;
+
+			bits = m_bits[ word ];
+		}
+	}
+
+	return ( wrap && idx > 0 ? nextChecked( 0 ) : -1 );
+}
+
+QVector< qsizetype >
+FrameModel::checkedIndices() const
+{
+	QVector< qsizetype > indices;
+	indices.reserve( m_checked );
+
+	for( size_t word = 0; word < m_bits.size(); ++word )
+	{
+		for( auto bits = m_bits[ word ]; bits; bits &= bits - 1 )
+			indices.push_back( static_cast< qsizetype > ( word * 64 +
+				qCountTrailingZeroBits( bits ) ) );
+	}
+
+	return indices;
+}
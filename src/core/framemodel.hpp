@@ -0,0 +1,158 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_FRAMEMODEL_HPP_INCLUDED
+#define GIF_EDITOR_CORE_FRAMEMODEL_HPP_INCLUDED
+
+// GIF editor include.
+#include "timeline.hpp"
+
+// Qt include.
+#include <QObject>
+#include <QVector>
+
+// C++ include.
+#include <vector>
+#include <functional>
+
+
+//
+// FrameModel
+//
+
+/*!
+	State of frames independent of widgets: checked flags and delays.
+
+	Checked flags are kept in a bitset with a directory of ranks of 64-bit
+	words, so count of checked frames is O(1), rank is O(1), select is
+	O(log n), and search of the next checked frame and collecting of checked
+	frames go word by word. The directory is rebuilt lazily after changes.
+
+	Bulk operations are applied as one batch with one checkedChanged()
+	for the range of really changed frames.
+
+	Delays of checked frames form the timeline of the animation, it's kept
+	in Fenwick tree, so seeking by time and start of frame are O(log n) and
+	are updated in O(log n) on check, uncheck or change of delay.
+
+	Frames are indexed from 0.
+*/
+class FrameModel final
+	:	public QObject
+{
+	Q_OBJECT
+
+signals:
+	//! Checked state of frames in range [first, last] changed.
+	void checkedChanged( int first, int last );
+	//! Delays of frames changed.
+	void delaysChanged();
+
+public:
+	explicit FrameModel( QObject * parent = nullptr );
+	~FrameModel() noexcept override;
+
+	//! Reset to checked frames with \a delays in milliseconds, without checkedChanged().
+	void reset( const QVector< int > & delays );
+	//! Clear.
+	void clear();
+	//! Append checked frames with \a delays in milliseconds, without checkedChanged().
+	void append( const QVector< int > & delays );
+	//! Remove unchecked frames, the rest are checked, without checkedChanged().
+	void removeUnchecked();
+	//! Move \a count frames starting at \a first, so they start at \a to, without
+	//! checkedChanged(). Only frames between the old and the new place are touched.
+	void move( int first, int count, int to );
+	//! Replace frames with frames at positions \a order, positions may repeat,
+	//! without checkedChanged().
+	void rearrange( const QVector< qsizetype > & order );
+
+	//! \return Count of frames.
+	int count() const;
+	//! \return Delay of frame in milliseconds.
+	int delay( int idx ) const;
+	//! Set delay of frames at \a indices to \a delay milliseconds.
+	void setDelay( const QVector< qsizetype > & indices, int delay );
+
+	//! \return Duration of animation of checked frames in milliseconds.
+	qint64 duration() const;
+	//! \return Start of frame in animation of checked frames in milliseconds.
+	qint64 startTime( int idx ) const;
+	//! \return Checked frame shown at \a msecs of animation, -1 if none.
+	int frameAt( qint64 msecs ) const;
+
+	//! \return Is frame checked?
+	bool isChecked( int idx ) const;
+	//! Set checked state of frame.
+	void setChecked( int idx, bool on = true );
+	//! Set checked state of frames in range [first, last].
+	void setChecked( int first, int last, bool on );
+	//! Check every \a n-th frame starting from \a offset, uncheck the others.
+	void checkEveryNth( int n, int offset = 0 );
+	//! Invert checked state of all frames.
+	void invert();
+	//! Check frames with delay in [minDelay, maxDelay], uncheck the others.
+	void checkByDelay( int minDelay, int maxDelay );
+	//! Set checked state of every frame to result of \a pred for its index.
+	void setCheckedIf( const std::function< bool ( int ) > & pred );
+
+	//! \return Count of checked frames.
+	int checkedCount() const;
+	//! \return Count of checked frames before \a idx.
+	int rank( int idx ) const;
+	//! \return Index of checked frame number \a n counting from 0, -1 if none.
+	int select( int n ) const;
+	//! \return The first checked frame at \a idx or after, -1 if none. With \a wrap
+	//! search continues from the start.
+	int nextChecked( int idx, bool wrap = false ) const;
+	//! \return Indices of checked frames.
+	QVector< qsizetype > checkedIndices() const;
+
+private:
+	//! Rebuild directory of ranks if needed.
+	void updateRanks() const;
+	//! Replace checked flags with \a bits and notify about changes.
+	void assign( std::vector< quint64 > && bits );
+	//! \return Duration of frame on timeline.
+	qint64 timeOf( int idx ) const;
+
+private:
+	Q_DISABLE_COPY( FrameModel )
+
+	//! Count of frames.
+	int m_count;
+	//! Count of checked frames.
+	int m_checked;
+	//! Checked flags, bits after the last frame are zero.
+	std::vector< quint64 > m_bits;
+	//! Count of checked frames before every word.
+	mutable std::vector< int > m_ranks;
+	//! Are ranks outdated?
+	mutable bool m_ranksDirty;
+	//! Delays.
+	QVector< int > m_delays;
+	//! Timeline of checked frames.
+	Timeline m_timeline;
+}; // class FrameModel
+
+#endif // GIF_EDITOR_CORE_FRAMEMODEL_HPP_INCLUDED
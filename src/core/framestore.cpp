@@ -0,0 +1,386 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "framestore.hpp"
+#include "trace.hpp"
+#include "metrics.hpp"
+#include "tempfiles.hpp"
+
+// Qt include.
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QPainter>
+
+// C++ include.
+#include <utility>
+
+
+//! Default limit of the cache of decoded frames.
+static const qint64 c_defaultCacheLimit = 256 * 1024 * 1024;
+
+
+QImage
+placeOnCanvas( const QImage & img, const QSize & canvas )
+{
+	if( canvas.isEmpty() || img.size() == canvas )
+		return img;
+
+	const auto scaled = ( img.width() > canvas.width() || img.height() > canvas.height() ?
+		img.scaled( canvas, Qt::KeepAspectRatio, Qt::SmoothTransformation ) : img );
+
+	QImage result( canvas, QImage::Format_ARGB32 );
+	result.fill( Qt::transparent );
+
+	QPainter p( &result );
+	p.drawImage( ( canvas.width() - scaled.width() ) / 2,
+		( canvas.height() - scaled.height() ) / 2, scaled );
+
+	return result;
+}
+
+
+//
+// FrameReader::Cache
+//
+
+struct FrameReader::Cache final {
+	Cache()
+		:	m_images( static_cast< qsizetype > ( c_defaultCacheLimit / 1024 ) )
+	{
+	}
+
+	//! Guard.
+	QMutex m_mutex;
+	//! Decoded frames, key is a file name, cost is in KiB.
+	QCache< QString, QImage > m_images;
+}; // struct FrameReader::Cache
+
+
+//
+// FrameReader
+//
+
+FrameReader::FrameReader( const std::shared_ptr< Cache > & cache )
+	:	m_cache( cache )
+{
+}
+
+QImage
+FrameReader::image( const FrameHandle & h ) const
+{
+	{
+		QMutexLocker lock( &m_cache->m_mutex );
+
+		if( const auto * img = m_cache->m_images.object( h.m_fileName ) )
+		{
+			Metrics::add( Metrics::instance().m_frameCacheHits );
+
+			return *img;
+		}
+	}
+
+	TRACE_SPAN( "decode_frame" );
+
+	auto & metrics = Metrics::instance();
+	Metrics::add( metrics.m_frameCacheMisses );
+
+	auto img = h.m_source->at( h.m_pos );
+
+	if( !h.m_canvas.isEmpty() && img.size() != h.m_canvas )
+		img = placeOnCanvas( img, h.m_canvas );
+
+	Metrics::add( metrics.m_framesDecoded );
+
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	m_cache->m_images.insert( h.m_fileName, new QImage( img ),
+		qMax( static_cast< qsizetype > ( 1 ), img.sizeInBytes() / 1024 ) );
+
+	return img;
+}
+
+
+//
+// FrameStore
+//
+
+FrameStore::FrameStore()
+	:	m_cache( std::make_shared< FrameReader::Cache > () )
+{
+}
+
+FrameStore::~FrameStore()
+{
+}
+
+bool
+FrameStore::load( const QString & fileName, const CancellationToken & token )
+{
+	TRACE_SPAN( "load" );
+
+	QElapsedTimer timer;
+	timer.start();
+
+	clear();
+
+	// Decoded frames are registered, so they are removed on quit that doesn't wait for jobs.
+	std::shared_ptr< QGifLib::Gif > gif( new QGifLib::Gif,
+		[] ( QGifLib::Gif * g )
+		{
+			TemporaryFiles::remove( g->fileNames() );
+
+			delete g;
+		} );
+
+	{
+		TRACE_SPAN( "decode" );
+
+		// Decoding in qgiflib can't be interrupted, so cancellation is checked after it.
+		if( !gif->load( fileName ) || token.isCancelled() )
+			return false;
+	}
+
+	const auto files = gif->fileNames();
+
+	TemporaryFiles::add( files );
+
+	QVector< FrameHandle > frames;
+	frames.reserve( gif->count() );
+
+	for( qsizetype i = 0; i < gif->count(); ++i )
+		frames.push_back( { gif, i, files.at( i ), gif->delay( i ) } );
+
+	m_frames.assign( std::move( frames ) );
+
+	if( token.isCancelled() )
+	{
+		clear();
+
+		return false;
+	}
+
+	if( !m_frames.isEmpty() )
+		m_size = image( 0 ).size();
+
+	Metrics::set( Metrics::instance().m_lastLoadMsecs, timer.elapsed() );
+
+	return true;
+}
+
+void
+FrameStore::append( FrameStore & other )
+{
+	if( isEmpty() )
+	{
+		swap( other );
+		other.clear();
+
+		return;
+	}
+
+	const bool fit = ( other.m_size != m_size );
+
+	for( auto & h : other.m_frames.toVector() )
+	{
+		if( fit )
+			h.m_canvas = m_size;
+
+		m_frames.push_back( std::move( h ) );
+	}
+
+	other.clear();
+}
+
+void
+FrameStore::clear()
+{
+	m_frames.clear();
+	m_size = QSize();
+
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	m_cache->m_images.clear();
+}
+
+qsizetype
+FrameStore::count() const
+{
+	return m_frames.size();
+}
+
+bool
+FrameStore::isEmpty() const
+{
+	return m_frames.isEmpty();
+}
+
+const FrameHandle &
+FrameStore::handle( qsizetype pos ) const
+{
+	return m_frames.at( pos );
+}
+
+void
+FrameStore::swap( FrameStore & other )
+{
+	m_frames.swap( other.m_frames );
+	std::swap( m_size, other.m_size );
+
+	{
+		QMutexLocker lock( &m_cache->m_mutex );
+
+		m_cache->m_images.clear();
+	}
+
+	QMutexLocker lock( &other.m_cache->m_mutex );
+
+	other.m_cache->m_images.clear();
+}
+
+void
+FrameStore::keep( const QVector< qsizetype > & positions )
+{
+	TRACE_SPAN( "compact" );
+
+	if( positions.isEmpty() )
+	{
+		clear();
+
+		return;
+	}
+
+	auto frames = m_frames.toVector();
+	QStringList removed;
+	qsizetype to = 0;
+	auto it = positions.cbegin();
+
+	for( qsizetype from = 0; from < frames.size(); ++from )
+	{
+		if( it != positions.cend() && *it == from )
+		{
+			if( to != from )
+				frames[ to ] = std::move( frames[ from ] );
+
+			++to;
+			++it;
+		}
+		else
+			removed.push_back( frames.at( from ).m_fileName );
+	}
+
+	frames.resize( to );
+	m_frames.assign( std::move( frames ) );
+
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	for( const auto & fileName : std::as_const( removed ) )
+		m_cache->m_images.remove( fileName );
+}
+
+void
+FrameStore::move( qsizetype first, qsizetype count, qsizetype to )
+{
+	m_frames.move( first, count, to );
+}
+
+void
+FrameStore::rearrange( const QVector< qsizetype > & order )
+{
+	const auto old = m_frames.toVector();
+
+	QVector< FrameHandle > frames;
+	frames.reserve( order.size() );
+
+	for( const auto & pos : order )
+		frames.push_back( old.at( pos ) );
+
+	m_frames.assign( std::move( frames ) );
+}
+
+QImage
+FrameStore::image( qsizetype pos ) const
+{
+	return image( m_frames.at( pos ) );
+}
+
+QImage
+FrameStore::image( const FrameHandle & h ) const
+{
+	return reader().image( h );
+}
+
+FrameReader
+FrameStore::reader() const
+{
+	return FrameReader( m_cache );
+}
+
+QSize
+FrameStore::size() const
+{
+	return m_size;
+}
+
+int
+FrameStore::delay( qsizetype pos ) const
+{
+	return m_frames.at( pos ).m_delay;
+}
+
+const QString &
+FrameStore::fileName( qsizetype pos ) const
+{
+	return m_frames.at( pos ).m_fileName;
+}
+
+qint64
+FrameStore::cacheLimit() const
+{
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	return static_cast< qint64 > ( m_cache->m_images.maxCost() ) * 1024;
+}
+
+void
+FrameStore::setCacheLimit( qint64 bytes )
+{
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	m_cache->m_images.setMaxCost( static_cast< qsizetype > ( bytes / 1024 ) );
+}
+
+qint64
+FrameStore::cacheSize() const
+{
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	return static_cast< qint64 > ( m_cache->m_images.totalCost() ) * 1024;
+}
+
+qsizetype
+FrameStore::cachedCount() const
+{
+	QMutexLocker lock( &m_cache->m_mutex );
+
+	return m_cache->m_images.count();
+}
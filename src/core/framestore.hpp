@@ -0,0 +1,201 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_FRAMESTORE_HPP_INCLUDED
+#define GIF_EDITOR_CORE_FRAMESTORE_HPP_INCLUDED
+
+// Qt include.
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QCache>
+#include <QMutex>
+
+// GIF editor include.
+#include "cancellation.hpp"
+#include "sequence.hpp"
+
+// qgiflib include.
+#include <qgiflib.hpp>
+
+// C++ include.
+#include <memory>
+
+
+//
+// FrameHandle
+//
+
+//! Handle of decoded frame.
+struct FrameHandle final {
+	//! Decoded GIF the frame belongs to.
+	std::shared_ptr< const QGifLib::Gif > m_source;
+	//! Position of the frame in the source.
+	qsizetype m_pos = 0;
+	//! File with decoded frame.
+	QString m_fileName;
+	//! Delay.
+	int m_delay = 0;
+	/*!
+		Canvas the frame of another size is placed on, it's the size of the
+		first GIF of the store. Empty means size of the frame.
+	*/
+	QSize m_canvas;
+}; // struct FrameHandle
+
+/*!
+	\return Image placed at the center of transparent \a canvas, it's scaled
+	down if it doesn't fit. Image of size of canvas or empty canvas gives
+	the image as is.
+*/
+QImage placeOnCanvas( const QImage & img, const QSize & canvas );
+
+
+//
+// FrameReader
+//
+
+/*!
+	Reader of decoded frames of the store.
+
+	Copies share the cache with the store and keep it alive, so a job
+	takes a reader and handles instead of a reference to the store and
+	may outlive the store. Thread-safe.
+*/
+class FrameReader final {
+public:
+	//! \return Decoded frame of the handle.
+	QImage image( const FrameHandle & h ) const;
+
+private:
+	friend class FrameStore;
+
+	struct Cache;
+
+	explicit FrameReader( const std::shared_ptr< Cache > & cache );
+
+	//! Cache of the store.
+	std::shared_ptr< Cache > m_cache;
+}; // class FrameReader
+
+
+//
+// FrameStore
+//
+
+/*!
+	Sequence of decoded frames.
+
+	Frames are addressed through handles, decoded images are cached
+	up to the cache limit. Order of handles is kept in Sequence, so
+	access by position and moving of frames are O(log n). All const
+	methods are thread-safe.
+*/
+class FrameStore final {
+public:
+	FrameStore();
+	~FrameStore();
+
+	//! Load GIF. \return Is GIF loaded and not cancelled?
+	bool load( const QString & fileName,
+		const CancellationToken & token = CancellationToken() );
+	/*!
+		Append frames of \a other, it's cleared.
+
+		Canvas of the store is the size of its first GIF and it stays so.
+		Frames of another size get it as canvas and are placed on it when
+		they are read, so all frames with canvas have the same one and it
+		doesn't depend on order of frames. Decoded GIFs are shared, nothing
+		is decoded again.
+	*/
+	void append( FrameStore & other );
+	//! Clear.
+	void clear();
+	//! Swap frames with other store, caches are dropped, limits are kept.
+	void swap( FrameStore & other );
+	/*!
+		Keep only frames at sorted \a positions.
+
+		Frames are compacted in one pass, cached images of
+		removed frames are dropped, nothing is decoded again.
+	*/
+	void keep( const QVector< qsizetype > & positions );
+	/*!
+		Move \a count frames starting at \a first, so they start at \a to.
+
+		Only handles are reordered, cache stays valid.
+	*/
+	void move( qsizetype first, qsizetype count, qsizetype to );
+	/*!
+		Replace frames with frames at positions \a order, positions may repeat.
+
+		New frames share handles, so decoded GIF and cached images,
+		with the old ones. Pixels are not copied.
+	*/
+	void rearrange( const QVector< qsizetype > & order );
+
+	//! \return Count of frames.
+	qsizetype count() const;
+	//! \return Is store empty?
+	bool isEmpty() const;
+	//! \return Handle of the frame.
+	const FrameHandle & handle( qsizetype pos ) const;
+	//! \return Decoded frame.
+	QImage image( qsizetype pos ) const;
+	/*!
+		\return Decoded frame of the handle.
+
+		Doesn't touch frames, so it's safe to call while
+		the store is cleared or swapped in another thread.
+	*/
+	QImage image( const FrameHandle & h ) const;
+	//! \return Reader of frames, it shares the cache with the store.
+	FrameReader reader() const;
+	//! \return Size of frames.
+	QSize size() const;
+	//! \return Delay of the frame.
+	int delay( qsizetype pos ) const;
+	//! \return File with decoded frame.
+	const QString & fileName( qsizetype pos ) const;
+
+	//! \return Cache limit in bytes.
+	qint64 cacheLimit() const;
+	//! Set cache limit in bytes.
+	void setCacheLimit( qint64 bytes );
+	//! \return Bytes held by the cache.
+	qint64 cacheSize() const;
+	//! \return Count of cached frames.
+	qsizetype cachedCount() const;
+
+private:
+	Q_DISABLE_COPY( FrameStore )
+
+	//! Frames.
+	Sequence< FrameHandle > m_frames;
+	//! Size of frames.
+	QSize m_size;
+	//! Cache of decoded frames shared with readers.
+	std::shared_ptr< FrameReader::Cache > m_cache;
+}; // class FrameStore
+
+#endif // GIF_EDITOR_CORE_FRAMESTORE_HPP_INCLUDED
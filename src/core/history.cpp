@@ -0,0 +1,50 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "history.hpp"
+
+
+//
+// EditCommand
+//
+
+EditCommand::EditCommand( EditStack & edits, const EditOperation & op, const QString & text )
+	:	QUndoCommand( text )
+	,	m_edits( edits )
+	,	m_before( edits )
+	,	m_after( edits )
+{
+	m_after.append( op );
+}
+
+void
+EditCommand::undo()
+{
+	m_edits = m_before;
+}
+
+void
+EditCommand::redo()
+{
+	m_edits = m_after;
+}
@@ -0,0 +1,66 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_HISTORY_HPP_INCLUDED
+#define GIF_EDITOR_CORE_HISTORY_HPP_INCLUDED
+
+// Qt include.
+#include <QUndoCommand>
+
+// GIF editor include.
+#include "edits.hpp"
+
+
+//
+// EditCommand
+//
+
+/*!
+	Undoable edit of the frames.
+
+	The command keeps versions of the edit stack before and after the edit.
+	Versions are implicitly shared with each other and with the document,
+	decoded frames are never touched, so undo and redo cost nothing
+	in pixel work and history grows only by operation records.
+*/
+class EditCommand final
+	:	public QUndoCommand
+{
+public:
+	EditCommand( EditStack & edits, const EditOperation & op, const QString & text );
+	~EditCommand() override = default;
+
+	void undo() override;
+	void redo() override;
+
+private:
+	Q_DISABLE_COPY( EditCommand )
+
+	//! Edit stack of the document.
+	EditStack & m_edits;
+	//! Edits before.
+	EditStack m_before;
+	//! Edits after.
+	EditStack m_after;
+}; // class EditCommand
+
+#endif // GIF_EDITOR_CORE_HISTORY_HPP_INCLUDED
@@ -0,0 +1,155 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "job.hpp"
+
+// C++ include.
+#include <exception>
+
+
+//
+// JobControl
+//
+
+JobControl::JobControl( const CancellationToken & token )
+	:	m_token( token )
+{
+}
+
+const CancellationToken &
+JobControl::token() const
+{
+	return m_token;
+}
+
+bool
+JobControl::isCancelled() const
+{
+	return m_token.isCancelled();
+}
+
+
+//
+// Job
+//
+
+Job::Job( QObject * parent )
+	:	QObject( parent )
+{
+}
+
+Job::~Job() noexcept
+{
+	m_token.cancel();
+	m_done = nullptr;
+}
+
+void
+Job::start( Function func, Continuation done, Scheduler::Priority priority )
+{
+	cancel();
+
+	m_token = CancellationToken();
+	m_done = std::move( done );
+
+	auto promise = std::make_shared< QPromise< bool > > ();
+
+	m_watcher = new QFutureWatcher< bool > ( this );
+
+	auto * watcher = m_watcher.data();
+
+	connect( watcher, &QFutureWatcher< bool >::finished, this,
+		[this, watcher] ()
+		{
+			if( watcher != m_watcher )
+				return;
+
+			const bool ok = ( watcher->resultCount() > 0 && watcher->result() );
+
+			finish( m_token.isCancelled() ? Result::Cancelled :
+				( ok ? Result::Succeeded : Result::Failed ) );
+		} );
+
+	watcher->setFuture( promise->future() );
+
+	const JobControl control( m_token );
+
+	Scheduler::instance().post( priority, [promise, control, func = std::move( func )] ()
+		{
+			promise->start();
+
+			bool ok = false;
+
+			try {
+				ok = ( !control.isCancelled() && func( control ) );
+			}
+			catch( const std::exception & )
+			{
+			}
+
+			promise->addResult( ok );
+			promise->finish();
+		} );
+}
+
+void
+Job::cancel()
+{
+	if( isRunning() )
+	{
+		m_token.cancel();
+
+		finish( Result::Cancelled );
+	}
+}
+
+bool
+Job::isRunning() const
+{
+	return !m_watcher.isNull();
+}
+
+void
+Job::detach()
+{
+	if( m_watcher )
+	{
+		m_watcher->disconnect( this );
+		m_watcher->deleteLater();
+		m_watcher.clear();
+	}
+}
+
+void
+Job::finish( Job::Result result )
+{
+	detach();
+
+	auto done = std::move( m_done );
+	m_done = nullptr;
+
+	emit finished( result );
+
+	if( done )
+		done( result );
+}
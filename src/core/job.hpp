@@ -0,0 +1,129 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_JOB_HPP_INCLUDED
+#define GIF_EDITOR_CORE_JOB_HPP_INCLUDED
+
+// GIF editor include.
+#include "cancellation.hpp"
+#include "scheduler.hpp"
+
+// Qt include.
+#include <QObject>
+#include <QFutureWatcher>
+#include <QPromise>
+#include <QPointer>
+
+// C++ include.
+#include <functional>
+#include <memory>
+
+
+//
+// JobControl
+//
+
+//! Control of the running job, given to the function of the job.
+class JobControl final {
+public:
+	explicit JobControl( const CancellationToken & token );
+
+	//! \return Cancellation token.
+	const CancellationToken & token() const;
+	//! \return Is cancellation requested?
+	bool isCancelled() const;
+
+private:
+	//! Token.
+	CancellationToken m_token;
+}; // class JobControl
+
+
+//
+// Job
+//
+
+/*!
+	Long operation in the scheduler.
+
+	Function of the job runs on a worker and should check cancellation
+	between steps. Continuation and signals are delivered in the thread
+	of the job object. Cancellation doesn't wait for the function: the
+	continuation is called at once with Result::Cancelled and the result
+	of the function is dropped, so the function must not refer to objects
+	that may die before it returns.
+*/
+class Job final
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	//! Result of the job.
+	enum class Result {
+		//! Function returned true.
+		Succeeded,
+		//! Function returned false.
+		Failed,
+		//! Job was cancelled.
+		Cancelled
+	}; // enum class Result
+
+	//! Function of the job. \return Is job succeeded?
+	using Function = std::function< bool ( const JobControl & ) >;
+	//! Continuation.
+	using Continuation = std::function< void ( Job::Result ) >;
+
+	explicit Job( QObject * parent = nullptr );
+	//! Running job is cancelled without continuation.
+	~Job() noexcept override;
+
+	//! Start job, running job is cancelled first.
+	void start( Function func, Continuation done = {},
+		Scheduler::Priority priority = Scheduler::Priority::Background );
+	//! Cancel running job.
+	void cancel();
+	//! \return Is job running?
+	bool isRunning() const;
+
+signals:
+	//! Job finished.
+	void finished( Job::Result result );
+
+private:
+	//! Finish job.
+	void finish( Job::Result result );
+	//! Detach from running function.
+	void detach();
+
+private:
+	Q_DISABLE_COPY( Job )
+
+	//! Watcher of the running function.
+	QPointer< QFutureWatcher< bool > > m_watcher;
+	//! Token of the running function.
+	CancellationToken m_token;
+	//! Continuation.
+	Continuation m_done;
+}; // class Job
+
+#endif // GIF_EDITOR_CORE_JOB_HPP_INCLUDED
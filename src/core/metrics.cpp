@@ -0,0 +1,42 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "metrics.hpp"
+
+
+//
+// Metrics
+//
+
+const int Metrics::c_stallBuckets;
+
+const qint64 Metrics::c_stallBounds[ Metrics::c_stallBuckets ] =
+	{ 100, 250, 500, 1000, 2000, -1 };
+
+Metrics &
+Metrics::instance()
+{
+	static Metrics metrics;
+
+	return metrics;
+}
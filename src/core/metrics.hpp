@@ -0,0 +1,89 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_METRICS_HPP_INCLUDED
+#define GIF_EDITOR_CORE_METRICS_HPP_INCLUDED
+
+// Qt include.
+#include <QtGlobal>
+
+// C++ include.
+#include <atomic>
+
+
+//
+// Metrics
+//
+
+//! Engine counters, updated from any thread without locks and sampled by UI.
+struct Metrics final {
+	//! Count of buckets of UI stalls.
+	static const int c_stallBuckets = 6;
+	//! Upper bounds of buckets of UI stalls in milliseconds, the last is unbounded.
+	static const qint64 c_stallBounds[ c_stallBuckets ];
+
+	//! \return Counters of the process.
+	static Metrics & instance();
+
+	//! Add \a value to \a counter.
+	static void add( std::atomic< qint64 > & counter, qint64 value = 1 )
+	{
+		counter.fetch_add( value, std::memory_order_relaxed );
+	}
+
+	//! Set \a counter to \a value.
+	static void set( std::atomic< qint64 > & counter, qint64 value )
+	{
+		counter.store( value, std::memory_order_relaxed );
+	}
+
+	//! \return Value of \a counter.
+	static qint64 get( const std::atomic< qint64 > & counter )
+	{
+		return counter.load( std::memory_order_relaxed );
+	}
+
+	//! Decoded frames.
+	std::atomic< qint64 > m_framesDecoded{ 0 };
+	//! Frames found in the cache of decoded frames.
+	std::atomic< qint64 > m_frameCacheHits{ 0 };
+	//! Frames not found in the cache of decoded frames.
+	std::atomic< qint64 > m_frameCacheMisses{ 0 };
+	//! Thumbnails drawn without creation.
+	std::atomic< qint64 > m_thumbnailHits{ 0 };
+	//! Thumbnails created before drawing.
+	std::atomic< qint64 > m_thumbnailMisses{ 0 };
+	//! Bytes held by thumbnails.
+	std::atomic< qint64 > m_thumbnailBytes{ 0 };
+	//! UI stalls by duration.
+	std::atomic< qint64 > m_stalls[ c_stallBuckets ] = {};
+	//! The longest UI stall in milliseconds.
+	std::atomic< qint64 > m_maxStallMsecs{ 0 };
+	//! Duration of the last load in milliseconds, -1 if there was no load.
+	std::atomic< qint64 > m_lastLoadMsecs{ -1 };
+	//! Duration of the last crop in milliseconds, -1 if there was no crop.
+	std::atomic< qint64 > m_lastCropMsecs{ -1 };
+	//! Duration of the last save in milliseconds, -1 if there was no save.
+	std::atomic< qint64 > m_lastSaveMsecs{ -1 };
+}; // struct Metrics
+
+#endif // GIF_EDITOR_CORE_METRICS_HPP_INCLUDED
@@ -0,0 +1,122 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_PARALLEL_HPP_INCLUDED
+#define GIF_EDITOR_CORE_PARALLEL_HPP_INCLUDED
+
+// GIF editor include.
+#include "scheduler.hpp"
+
+// Qt include.
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+// C++ include.
+#include <atomic>
+#include <memory>
+
+
+/*!
+	Call \a func for each index in [0, count) on the calling thread and
+	on workers of the scheduler with the given priority. The calling thread
+	doesn't wait for helpers that didn't start before it finished, so nested
+	use from workers never waits for a free worker. Helper takes one index
+	per task and posts itself again, so tasks of higher priority are taken
+	by workers between indices.
+*/
+template< typename Func >
+void
+parallelFor( int count, Func func,
+	Scheduler::Priority priority = Scheduler::Priority::Background )
+{
+	//! State shared with helpers, it outlives the call for late helpers.
+	struct State {
+		std::atomic< int > m_next{ 0 };
+		QMutex m_mutex;
+		QWaitCondition m_done;
+		int m_active = 0;
+		bool m_closed = false;
+	}; // struct State
+
+	//! Helper task, it runs one index.
+	struct Helper {
+		//! State.
+		std::shared_ptr< State > m_state;
+		//! Function, it's touched only while the call is not closed.
+		Func * m_func;
+		//! Count of indices.
+		int m_count;
+		//! Priority.
+		Scheduler::Priority m_priority;
+
+		void operator () () const
+		{
+			{
+				QMutexLocker lock( &m_state->m_mutex );
+
+				if( m_state->m_closed )
+					return;
+
+				++m_state->m_active;
+			}
+
+			const int i = m_state->m_next++;
+
+			if( i < m_count )
+				( *m_func )( i );
+
+			bool more = false;
+
+			{
+				QMutexLocker lock( &m_state->m_mutex );
+
+				more = ( !m_state->m_closed && m_state->m_next < m_count );
+
+				if( --m_state->m_active == 0 )
+					m_state->m_done.wakeAll();
+			}
+
+			if( more )
+				Scheduler::instance().post( m_priority, *this );
+		}
+	}; // struct Helper
+
+	auto state = std::make_shared< State > ();
+
+	auto & scheduler = Scheduler::instance();
+
+	for( int i = 1; i < count && i < scheduler.threadCount(); ++i )
+		scheduler.post( priority, Helper{ state, &func, count, priority } );
+
+	for( int i = state->m_next++; i < count; i = state->m_next++ )
+		func( i );
+
+	QMutexLocker lock( &state->m_mutex );
+
+	state->m_closed = true;
+
+	while( state->m_active > 0 )
+		state->m_done.wait( &state->m_mutex );
+}
+
+#endif // GIF_EDITOR_CORE_PARALLEL_HPP_INCLUDED
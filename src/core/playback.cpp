@@ -0,0 +1,305 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// GIF editor include.
+#include "playback.hpp"
+#include "document.hpp"
+#include "trace.hpp"
+
+// Qt include.
+#include <QThread>
+
+// C++ include.
+#include <algorithm>
+
+
+//
+// PlaybackClock
+//
+
+PlaybackClock::PlaybackClock()
+	:	m_offset( 0 )
+	,	m_last( -1 )
+	,	m_shown( 0 )
+	,	m_dropped( 0 )
+	,	m_elapsed( 0 )
+{
+}
+
+void
+PlaybackClock::start( const QVector< int > & delays, int first )
+{
+	m_timeline.clear();
+	m_timeline.reserve( delays.size() + 1 );
+	m_timeline.push_back( 0 );
+
+	for( const auto & delay : delays )
+		m_timeline.push_back( m_timeline.back() + qMax( delay, c_minFrameDelay ) );
+
+	m_offset = ( first > 0 && first < delays.size() ? m_timeline.at( first ) : 0 );
+	m_last = -1;
+	m_shown = 0;
+	m_dropped = 0;
+	m_elapsed = 0;
+
+	if( delays.isEmpty() )
+		m_clock.invalidate();
+	else
+		m_clock.start();
+}
+
+void
+PlaybackClock::stop()
+{
+	if( m_clock.isValid() )
+		m_elapsed = m_clock.elapsed();
+
+	m_clock.invalidate();
+}
+
+bool
+PlaybackClock::isRunning() const
+{
+	return m_clock.isValid();
+}
+
+PlaybackClock::Tick
+PlaybackClock::tick()
+{
+	if( !isRunning() )
+		return {};
+
+	return tick( m_clock.elapsed() );
+}
+
+PlaybackClock::Tick
+PlaybackClock::tick( qint64 msecs ) const
+{
+	Tick t;
+
+	if( m_timeline.size() < 2 )
+		return t;
+
+	const auto duration = m_timeline.back();
+	const auto absolute = m_offset + msecs;
+	const auto loop = absolute / duration;
+	const auto pos = absolute % duration;
+
+	t.m_frame = static_cast< int > ( std::upper_bound( m_timeline.cbegin(), m_timeline.cend(), pos ) -
+		m_timeline.cbegin() ) - 1;
+	t.m_wait = m_timeline.at( t.m_frame + 1 ) - pos;
+
+	// Frames are counted from the start of playback, not from the first frame.
+	t.m_sequence = loop * count() + t.m_frame;
+
+	return t;
+}
+
+void
+PlaybackClock::present( qint64 sequence )
+{
+	if( sequence <= m_last )
+		return;
+
+	if( m_last >= 0 )
+		m_dropped += sequence - m_last - 1;
+
+	++m_shown;
+	m_last = sequence;
+}
+
+int
+PlaybackClock::count() const
+{
+	return static_cast< int > ( m_timeline.size() ) - 1;
+}
+
+qint64
+PlaybackClock::elapsed() const
+{
+	return ( isRunning() ? m_clock.elapsed() : m_elapsed );
+}
+
+qint64
+PlaybackClock::lastPresented() const
+{
+	return m_last;
+}
+
+qint64
+PlaybackClock::shownFrames() const
+{
+	return m_shown;
+}
+
+qint64
+PlaybackClock::droppedFrames() const
+{
+	return m_dropped;
+}
+
+double
+PlaybackClock::targetFps() const
+{
+	return ( count() > 0 ? count() * 1000.0 / m_timeline.back() : 0.0 );
+}
+
+double
+PlaybackClock::achievedFps() const
+{
+	const auto msecs = elapsed();
+
+	return ( msecs > 0 ? m_shown * 1000.0 / msecs : 0.0 );
+}
+
+
+//
+// PlaybackRenderer
+//
+
+const int PlaybackRenderer::c_capacity;
+
+PlaybackRenderer::PlaybackRenderer()
+	:	m_ring( c_capacity )
+	,	m_free( 0 )
+	,	m_wanted( 0 )
+	,	m_stopped( true )
+	,	m_frames( nullptr )
+{
+}
+
+PlaybackRenderer::~PlaybackRenderer()
+{
+	stop();
+}
+
+void
+PlaybackRenderer::start( const Document & doc, const QVector< qsizetype > & positions,
+	const QSize & size, qint64 sequence )
+{
+	stop();
+
+	if( positions.isEmpty() || size.isEmpty() )
+		return;
+
+	m_frames = &doc.frames();
+	m_edits = doc.edits();
+	m_size = size;
+	m_handles.clear();
+	m_handles.reserve( positions.size() );
+
+	for( const auto & pos : positions )
+		m_handles.push_back( doc.frames().handle( pos ) );
+
+	m_wanted.store( sequence, std::memory_order_relaxed );
+	m_stopped.store( false, std::memory_order_relaxed );
+	m_free.release( static_cast< int > ( m_ring.capacity() ) );
+
+	m_thread.reset( QThread::create( [this] () { run(); } ) );
+	m_thread->setObjectName( QStringLiteral( "playback" ) );
+	m_thread->start();
+}
+
+void
+PlaybackRenderer::stop()
+{
+	if( !m_thread )
+		return;
+
+	m_stopped.store( true, std::memory_order_release );
+	m_free.release();
+	m_thread->wait();
+	m_thread.reset();
+
+	Item item;
+
+	while( m_ring.pop( item ) )
+		;
+
+	m_free.acquire( m_free.available() );
+}
+
+bool
+PlaybackRenderer::isRunning() const
+{
+	return !!m_thread;
+}
+
+const QSize &
+PlaybackRenderer::size() const
+{
+	return m_size;
+}
+
+QImage
+PlaybackRenderer::take( qint64 sequence )
+{
+	while( auto * item = m_ring.front() )
+	{
+		if( item->m_sequence > sequence )
+			return {};
+
+		Item taken;
+		m_ring.pop( taken );
+		m_free.release();
+
+		if( taken.m_sequence == sequence )
+		{
+			m_wanted.store( sequence + 1, std::memory_order_relaxed );
+
+			return taken.m_image;
+		}
+	}
+
+	// Renderer is behind, it skips to the wanted frame.
+	m_wanted.store( sequence, std::memory_order_relaxed );
+
+	return {};
+}
+
+void
+PlaybackRenderer::run()
+{
+	qint64 next = 0;
+
+	while( true )
+	{
+		m_free.acquire();
+
+		if( m_stopped.load( std::memory_order_acquire ) )
+			return;
+
+		next = qMax( next, m_wanted.load( std::memory_order_relaxed ) );
+
+		TRACE_SPAN( "prerender" );
+
+		Item item;
+		item.m_sequence = next;
+		item.m_image = m_edits.render( m_frames->image( m_handles.at( next % m_handles.size() ) ),
+			m_size );
+
+		m_ring.push( std::move( item ) );
+
+		++next;
+	}
+}
@@ -0,0 +1,199 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_PLAYBACK_HPP_INCLUDED
+#define GIF_EDITOR_CORE_PLAYBACK_HPP_INCLUDED
+
+// GIF editor include.
+#include "framestore.hpp"
+#include "edits.hpp"
+#include "ringbuffer.hpp"
+#include "timeline.hpp"
+
+// Qt include.
+#include <QVector>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QSemaphore>
+
+// C++ include.
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+class Document;
+
+
+//
+// PlaybackClock
+//
+
+/*!
+	Clock of playback.
+
+	Frames are placed on the cumulative timeline of their delays, and the frame
+	to show is chosen by the monotonic clock against this timeline, so time
+	spent in decoding and drawing doesn't accumulate as drift. Frames which
+	time passed before they were presented are counted as dropped.
+	Playback loops.
+*/
+class PlaybackClock final {
+public:
+	//! Result of tick.
+	struct Tick final {
+		//! Index of frame to show, -1 if not running.
+		int m_frame = -1;
+		//! Milliseconds to the next frame.
+		qint64 m_wait = 0;
+		//! Number of frame counting from start of playback.
+		qint64 m_sequence = -1;
+	}; // struct Tick
+
+	PlaybackClock();
+
+	//! Start playback of frames with \a delays in milliseconds from frame \a first.
+	void start( const QVector< int > & delays, int first = 0 );
+	//! Stop playback.
+	void stop();
+	//! \return Is playback running?
+	bool isRunning() const;
+
+	//! \return Frame to show now.
+	Tick tick();
+	//! \return Frame to show at \a msecs since start.
+	Tick tick( qint64 msecs ) const;
+	//! Frame \a sequence was shown, frames skipped before it are dropped.
+	void present( qint64 sequence );
+
+	//! \return Count of frames.
+	int count() const;
+	//! \return Milliseconds since start.
+	qint64 elapsed() const;
+	//! \return Sequence of the last shown frame, -1 if none.
+	qint64 lastPresented() const;
+	//! \return Count of shown frames.
+	qint64 shownFrames() const;
+	//! \return Count of dropped frames.
+	qint64 droppedFrames() const;
+	//! \return Frames per second of the animation.
+	double targetFps() const;
+	//! \return Achieved frames per second.
+	double achievedFps() const;
+
+private:
+	Q_DISABLE_COPY( PlaybackClock )
+
+	//! Start of every frame on the timeline, the last item is the duration.
+	QVector< qint64 > m_timeline;
+	//! Offset of the first frame on the timeline.
+	qint64 m_offset;
+	//! Clock.
+	QElapsedTimer m_clock;
+	//! Sequence of the last shown frame, -1 if none.
+	qint64 m_last;
+	//! Shown frames.
+	qint64 m_shown;
+	//! Dropped frames.
+	qint64 m_dropped;
+	//! Milliseconds of playback when it was stopped.
+	qint64 m_elapsed;
+}; // class PlaybackClock
+
+
+
+//
+// PlaybackRenderer
+//
+
+/*!
+	Renderer of frames for playback.
+
+	Worker thread renders frames in order of playback, already edited and
+	scaled to the size of view, into the ring buffer, so GUI thread only
+	draws them. If GUI falls behind, renderer skips to the wanted frame.
+*/
+class PlaybackRenderer final {
+public:
+	//! Count of frames rendered ahead.
+	static const int c_capacity = 8;
+
+	PlaybackRenderer();
+	~PlaybackRenderer();
+
+	/*!
+		Start rendering of frames at \a positions of \a doc scaled to \a size,
+		beginning from frame \a sequence. Frame with sequence \c n is at
+		position \c n modulo count of positions. Document shouldn't be
+		changed while rendering is running.
+	*/
+	void start( const Document & doc, const QVector< qsizetype > & positions,
+		const QSize & size, qint64 sequence = 0 );
+	//! Stop rendering.
+	void stop();
+	//! \return Is rendering running?
+	bool isRunning() const;
+	//! \return Size of rendered frames.
+	const QSize & size() const;
+
+	//! \return Image of frame \a sequence, null if it's not rendered yet.
+	//! Older frames are dropped.
+	QImage take( qint64 sequence );
+
+private:
+	Q_DISABLE_COPY( PlaybackRenderer )
+
+	//! Render frames.
+	void run();
+
+	//! Rendered frame.
+	struct Item final {
+		//! Number of frame.
+		qint64 m_sequence = -1;
+		//! Image.
+		QImage m_image;
+	}; // struct Item
+
+	//! Rendered frames.
+	RingBuffer< Item > m_ring;
+	//! Free slots in the ring.
+	QSemaphore m_free;
+	//! The first frame wanted by GUI.
+	std::atomic< qint64 > m_wanted;
+	//! Stop flag.
+	std::atomic< bool > m_stopped;
+	//! Worker thread.
+	std::unique_ptr< QThread > m_thread;
+	//! Frames.
+	const FrameStore * m_frames;
+	//! Handles of frames in order of playback.
+	QVector< FrameHandle > m_handles;
+	//! Edits.
+	EditStack m_edits;
+	//! Size of frames.
+	QSize m_size;
+}; // class PlaybackRenderer
+
+#endif // GIF_EDITOR_CORE_PLAYBACK_HPP_INCLUDED
@@ -0,0 +1,117 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "progress.hpp"
+
+// C++ include.
+#include <chrono>
+
+
+namespace /* anonymous */ {
+
+//! \return Nanoseconds of steady clock.
+qint64
+now()
+{
+	return std::chrono::duration_cast< std::chrono::nanoseconds > (
+		std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+} /* namespace anonymous */
+
+
+//
+// Progress::Sample
+//
+
+int
+Progress::Sample::percent() const
+{
+	if( m_total <= 0 )
+		return -1;
+
+	return static_cast< int > ( qBound( Q_INT64_C( 0 ), m_done * 100 / m_total,
+		Q_INT64_C( 100 ) ) );
+}
+
+double
+Progress::Sample::framesPerSecond() const
+{
+	return ( m_msecs > 0 ? (double) m_done * 1000.0 / (double) m_msecs : 0.0 );
+}
+
+qint64
+Progress::Sample::eta() const
+{
+	if( m_total <= 0 || m_done <= 0 )
+		return -1;
+
+	// Measured throughput of the stage, not an assumed one.
+	return qMax( Q_INT64_C( 0 ), ( m_total - m_done ) * m_msecs / m_done );
+}
+
+
+//
+// Progress
+//
+
+Progress::Progress()
+	:	m_stage( static_cast< int > ( Stage::Idle ) )
+	,	m_done( 0 )
+	,	m_total( 0 )
+	,	m_start( now() )
+{
+}
+
+void
+Progress::begin( Stage stage, qint64 total )
+{
+	m_done.store( 0, std::memory_order_relaxed );
+	m_total.store( total, std::memory_order_relaxed );
+	m_start.store( now(), std::memory_order_relaxed );
+	m_stage.store( static_cast< int > ( stage ), std::memory_order_relaxed );
+}
+
+void
+Progress::add( qint64 count )
+{
+	m_done.fetch_add( count, std::memory_order_relaxed );
+}
+
+void
+Progress::setDone( qint64 done )
+{
+	m_done.store( done, std::memory_order_relaxed );
+}
+
+Progress::Sample
+Progress::sample() const
+{
+	Sample s;
+	s.m_stage = static_cast< Stage > ( m_stage.load( std::memory_order_relaxed ) );
+	s.m_done = m_done.load( std::memory_order_relaxed );
+	s.m_total = m_total.load( std::memory_order_relaxed );
+	s.m_msecs = ( now() - m_start.load( std::memory_order_relaxed ) ) / 1000000;
+
+	return s;
+}
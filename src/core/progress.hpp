@@ -0,0 +1,106 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_PROGRESS_HPP_INCLUDED
+#define GIF_EDITOR_CORE_PROGRESS_HPP_INCLUDED
+
+// Qt include.
+#include <QtGlobal>
+
+// C++ include.
+#include <atomic>
+
+
+//
+// Progress
+//
+
+/*!
+	Progress of a long operation.
+
+	Workers bump counters with relaxed atomics, UI samples them on a timer.
+	Fields of a sample may belong to neighbouring moments, that's fine
+	for displaying.
+*/
+class Progress final {
+public:
+	//! Stage of the operation.
+	enum class Stage {
+		//! Nothing is running.
+		Idle,
+		//! Decoding of GIF.
+		Decoding,
+		//! Creating of frames on tape.
+		Building,
+		//! Applying edits to frames.
+		Rendering,
+		//! Quantization and encoding of GIF.
+		Encoding,
+		//! Comparison of frames.
+		Comparing
+	}; // enum class Stage
+
+	//! Sample of progress.
+	struct Sample final {
+		//! Stage.
+		Stage m_stage = Stage::Idle;
+		//! Done frames.
+		qint64 m_done = 0;
+		//! All frames, 0 if unknown.
+		qint64 m_total = 0;
+		//! Milliseconds since start of the stage.
+		qint64 m_msecs = 0;
+
+		//! \return Percent, -1 if unknown.
+		int percent() const;
+		//! \return Frames per second.
+		double framesPerSecond() const;
+		//! \return Estimated milliseconds to the end of the stage, -1 if unknown.
+		qint64 eta() const;
+	}; // struct Sample
+
+	Progress();
+
+	//! Start \a stage with \a total frames, 0 if unknown.
+	void begin( Stage stage, qint64 total = 0 );
+	//! Add \a count done frames.
+	void add( qint64 count = 1 );
+	//! Set done frames.
+	void setDone( qint64 done );
+
+	//! \return Sample.
+	Sample sample() const;
+
+private:
+	Q_DISABLE_COPY( Progress )
+
+	//! Stage.
+	std::atomic< int > m_stage;
+	//! Done frames.
+	std::atomic< qint64 > m_done;
+	//! All frames.
+	std::atomic< qint64 > m_total;
+	//! Start of the stage, nanoseconds of steady clock.
+	std::atomic< qint64 > m_start;
+}; // class Progress
+
+#endif // GIF_EDITOR_CORE_PROGRESS_HPP_INCLUDED
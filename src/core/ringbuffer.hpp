@@ -0,0 +1,128 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_RINGBUFFER_HPP_INCLUDED
+#define GIF_EDITOR_CORE_RINGBUFFER_HPP_INCLUDED
+
+// Qt include.
+#include <QtGlobal>
+
+// C++ include.
+#include <atomic>
+#include <vector>
+#include <utility>
+
+
+//
+// RingBuffer
+//
+
+/*!
+	Bounded lock-free queue of one producer and one consumer.
+
+	Producer only writes the tail and consumer only writes the head, each
+	of them on its own cache line. Capacity is rounded up to power of two.
+*/
+template< typename T >
+class RingBuffer final {
+public:
+	explicit RingBuffer( size_t capacity )
+		:	m_head( 0 )
+		,	m_tail( 0 )
+	{
+		size_t size = 1;
+
+		while( size < capacity )
+			size <<= 1;
+
+		m_items.resize( size );
+		m_mask = size - 1;
+	}
+
+	//! \return Capacity.
+	size_t capacity() const
+	{
+		return m_items.size();
+	}
+
+	//! \return Count of items, approximate if called not by producer or consumer.
+	size_t size() const
+	{
+		return m_tail.load( std::memory_order_acquire ) -
+			m_head.load( std::memory_order_acquire );
+	}
+
+	//! Push \a value. Producer only. \return false if buffer is full.
+	bool push( T && value )
+	{
+		const auto tail = m_tail.load( std::memory_order_relaxed );
+
+		if( tail - m_head.load( std::memory_order_acquire ) == m_items.size() )
+			return false;
+
+		m_items[ tail & m_mask ] = std::move( value );
+		m_tail.store( tail + 1, std::memory_order_release );
+
+		return true;
+	}
+
+	//! \return The oldest item, null if buffer is empty. Consumer only.
+	T * front()
+	{
+		const auto head = m_head.load( std::memory_order_relaxed );
+
+		if( head == m_tail.load( std::memory_order_acquire ) )
+			return nullptr;
+
+		return &m_items[ head & m_mask ];
+	}
+
+	//! Pop the oldest item into \a value. Consumer only. \return false if buffer is empty.
+	bool pop( T & value )
+	{
+		auto * item = front();
+
+		if( !item )
+			return false;
+
+		value = std::move( *item );
+		*item = T();
+		m_head.store( m_head.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+
+		return true;
+	}
+
+private:
+	Q_DISABLE_COPY( RingBuffer )
+
+	//! Items.
+	std::vector< T > m_items;
+	//! Mask of index.
+	size_t m_mask;
+	//! Next item to pop, written by consumer.
+	alignas( 64 ) std::atomic< size_t > m_head;
+	//! Next item to push, written by producer.
+	alignas( 64 ) std::atomic< size_t > m_tail;
+}; // class RingBuffer
+
+#endif // GIF_EDITOR_CORE_RINGBUFFER_HPP_INCLUDED
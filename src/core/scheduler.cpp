@@ -0,0 +1,275 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "scheduler.hpp"
+
+// Qt include.
+#include <QThread>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+
+// C++ include.
+#include <deque>
+
+
+namespace /* anonymous */ {
+
+//! Count of threads for Scheduler::instance().
+std::atomic< int > s_defaultThreads( 0 );
+
+//! Scheduler of the current worker thread.
+thread_local const Scheduler * t_scheduler = nullptr;
+//! Index of the current worker thread.
+thread_local int t_index = -1;
+
+} /* namespace anonymous */
+
+
+//
+// Scheduler::Worker
+//
+
+struct Scheduler::Worker final {
+	//! Guard of deques, owner and thieves lock it.
+	QMutex m_mutex;
+	//! Deques per priority.
+	std::deque< Task > m_tasks[ c_priorities ];
+	//! Thread.
+	std::unique_ptr< QThread > m_thread;
+}; // struct Scheduler::Worker
+
+
+//
+// Scheduler
+//
+
+const int Scheduler::c_priorities;
+
+Scheduler::Scheduler( int threads )
+	:	m_queued( 0 )
+	,	m_active( 0 )
+	,	m_next( 0 )
+	,	m_stop( false )
+{
+	for( auto & p : m_pending )
+		p.store( 0 );
+
+	const int count = ( threads > 0 ? threads : qMax( 1, QThread::idealThreadCount() ) );
+
+	m_workers.reserve( static_cast< size_t > ( count ) );
+
+	for( int i = 0; i < count; ++i )
+		m_workers.push_back( std::make_unique< Worker > () );
+
+	for( int i = 0; i < count; ++i )
+	{
+		auto & w = m_workers[ static_cast< size_t > ( i ) ];
+		w->m_thread.reset( QThread::create( [this, i] () { run( i ); } ) );
+		w->m_thread->setObjectName( QStringLiteral( "worker" ) );
+		w->m_thread->start();
+	}
+}
+
+Scheduler::~Scheduler()
+{
+	{
+		QMutexLocker lock( &m_sleepMutex );
+
+		m_stop = true;
+
+		m_wake.wakeAll();
+	}
+
+	for( auto & w : m_workers )
+		w->m_thread->wait();
+}
+
+Scheduler &
+Scheduler::instance()
+{
+	static Scheduler scheduler( s_defaultThreads.load() );
+
+	return scheduler;
+}
+
+void
+Scheduler::setDefaultThreadCount( int threads )
+{
+	s_defaultThreads = threads;
+}
+
+void
+Scheduler::post( Priority priority, Task task )
+{
+	const auto p = static_cast< int > ( priority );
+	const auto count = static_cast< unsigned int > ( m_workers.size() );
+	const auto target = ( t_scheduler == this ? static_cast< unsigned int > ( t_index ) :
+		m_next++ % count );
+
+	{
+		auto & w = m_workers[ target ];
+
+		QMutexLocker lock( &w->m_mutex );
+
+		w->m_tasks[ p ].push_back( std::move( task ) );
+	}
+
+	++m_pending[ p ];
+	++m_queued;
+
+	QMutexLocker lock( &m_sleepMutex );
+
+	m_wake.wakeOne();
+}
+
+int
+Scheduler::threadCount() const
+{
+	return static_cast< int > ( m_workers.size() );
+}
+
+int
+Scheduler::activeCount() const
+{
+	return m_active.load( std::memory_order_relaxed );
+}
+
+qint64
+Scheduler::queuedCount() const
+{
+	return m_queued.load( std::memory_order_relaxed );
+}
+
+qint64
+Scheduler::queuedCount( Priority priority ) const
+{
+	return m_pending[ static_cast< int > ( priority ) ].load( std::memory_order_relaxed );
+}
+
+bool
+Scheduler::waitForDone( qint64 msecs )
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	QMutexLocker lock( &m_sleepMutex );
+
+	while( m_queued > 0 || m_active > 0 )
+	{
+		qint64 wait = 100;
+
+		if( msecs >= 0 )
+		{
+			wait = qMin( wait, msecs - timer.elapsed() );
+
+			if( wait <= 0 )
+				return false;
+		}
+
+		m_idle.wait( &m_sleepMutex, static_cast< unsigned long > ( wait ) );
+	}
+
+	return true;
+}
+
+bool
+Scheduler::take( int self, Task & task )
+{
+	const int count = static_cast< int > ( m_workers.size() );
+
+	for( int p = 0; p < c_priorities; ++p )
+	{
+		if( m_pending[ p ].load( std::memory_order_relaxed ) <= 0 )
+			continue;
+
+		// Own deque from the back, others from the front.
+		for( int k = 0; k < count; ++k )
+		{
+			auto & w = m_workers[ static_cast< size_t > ( ( self + k ) % count ) ];
+
+			QMutexLocker lock( &w->m_mutex );
+
+			auto & q = w->m_tasks[ p ];
+
+			if( q.empty() )
+				continue;
+
+			if( k == 0 )
+			{
+				task = std::move( q.back() );
+				q.pop_back();
+			}
+			else
+			{
+				task = std::move( q.front() );
+				q.pop_front();
+			}
+
+			// Active before not queued, so waitForDone() never sees both zero too early.
+			++m_active;
+			--m_pending[ p ];
+			--m_queued;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+Scheduler::run( int self )
+{
+	t_scheduler = this;
+	t_index = self;
+
+	while( true )
+	{
+		Task task;
+
+		if( take( self, task ) )
+		{
+			task();
+			task = nullptr;
+
+			if( --m_active == 0 && m_queued == 0 )
+			{
+				QMutexLocker lock( &m_sleepMutex );
+
+				m_idle.wakeAll();
+			}
+
+			continue;
+		}
+
+		QMutexLocker lock( &m_sleepMutex );
+
+		if( m_queued > 0 )
+			continue;
+
+		if( m_stop )
+			return;
+
+		m_wake.wait( &m_sleepMutex );
+	}
+}
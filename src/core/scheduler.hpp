@@ -0,0 +1,130 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_SCHEDULER_HPP_INCLUDED
+#define GIF_EDITOR_CORE_SCHEDULER_HPP_INCLUDED
+
+// Qt include.
+#include <QMutex>
+#include <QWaitCondition>
+
+// C++ include.
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+//
+// Scheduler
+//
+
+/*!
+	Pool of worker threads for engine tasks.
+
+	Every worker has a deque per priority. A task posted from a worker
+	goes to its own deque, other tasks are spread round-robin. Worker takes
+	the highest priority task available: from the back of its own deque
+	first, then from the front of other workers' deques. So queued
+	background export never delays interactive work longer than one
+	running task, parallelFor() keeps tasks short by posting one index
+	per task.
+*/
+class Scheduler final {
+public:
+	//! Priority of task, from the highest to the lowest.
+	enum class Priority {
+		//! Frame the user is looking at.
+		Interactive = 0,
+		//! Thumbnails visible on tape.
+		Thumbnail,
+		//! Frames that will likely be needed soon.
+		Prefetch,
+		//! Load, export and batch processing.
+		Background
+	}; // enum class Priority
+
+	//! Count of priorities.
+	static const int c_priorities = 4;
+
+	//! Task.
+	using Task = std::function< void () >;
+
+	//! \a threads 0 means ideal thread count.
+	explicit Scheduler( int threads = 0 );
+	//! Runs queued tasks and stops workers.
+	~Scheduler();
+
+	//! \return Scheduler of the application.
+	static Scheduler & instance();
+	//! Set count of threads of instance(), should be called before the first instance().
+	static void setDefaultThreadCount( int threads );
+
+	//! Post task.
+	void post( Priority priority, Task task );
+
+	//! \return Count of threads.
+	int threadCount() const;
+	//! \return Count of running tasks.
+	int activeCount() const;
+	//! \return Count of queued tasks.
+	qint64 queuedCount() const;
+	//! \return Count of queued tasks with the given priority.
+	qint64 queuedCount( Priority priority ) const;
+
+	/*!
+		Wait until all tasks are done, but not longer than \a msecs,
+		negative waits without limit. \return Are all tasks done?
+	*/
+	bool waitForDone( qint64 msecs = -1 );
+
+private:
+	Q_DISABLE_COPY( Scheduler )
+
+	struct Worker;
+
+	//! Take task for worker \a self. \return Is task taken?
+	bool take( int self, Task & task );
+	//! Loop of worker \a self.
+	void run( int self );
+
+	//! Workers.
+	std::vector< std::unique_ptr< Worker > > m_workers;
+	//! Guard of sleeping.
+	QMutex m_sleepMutex;
+	//! Workers wait for tasks.
+	QWaitCondition m_wake;
+	//! Waiting for done.
+	QWaitCondition m_idle;
+	//! Queued tasks per priority.
+	std::atomic< qint64 > m_pending[ c_priorities ];
+	//! Queued tasks.
+	std::atomic< qint64 > m_queued;
+	//! Running tasks.
+	std::atomic< int > m_active;
+	//! Next worker for tasks posted from outside.
+	std::atomic< unsigned int > m_next;
+	//! Stop flag.
+	std::atomic< bool > m_stop;
+}; // class Scheduler
+
+#endif // GIF_EDITOR_CORE_SCHEDULER_HPP_INCLUDED
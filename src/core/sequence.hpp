@@ -0,0 +1,333 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_SEQUENCE_HPP_INCLUDED
+#define GIF_EDITOR_CORE_SEQUENCE_HPP_INCLUDED
+
+// Qt include.
+#include <QtGlobal>
+#include <QVector>
+
+// C++ include.
+#include <vector>
+#include <utility>
+
+
+//
+// Sequence
+//
+
+/*!
+	Sequence with O(log n) access by position and O(log n) move of ranges.
+
+	This is an implicit treap: nodes are ordered by position, sizes of
+	subtrees give positions, random priorities keep the tree balanced.
+	Moving of a range is three splits and three merges, items are never
+	copied. Nodes live in one vector and are linked by indices.
+
+	Const methods don't change the tree, so they may be called from many
+	threads while nobody changes the sequence.
+*/
+template< typename T >
+class Sequence final {
+public:
+	Sequence()
+		:	m_root( -1 )
+		,	m_seed( 2463534242u )
+	{
+	}
+
+	//! \return Count of items.
+	qsizetype size() const
+	{
+		return sizeOf( m_root );
+	}
+
+	//! \return Is sequence empty?
+	bool isEmpty() const
+	{
+		return m_root < 0;
+	}
+
+	//! Clear.
+	void clear()
+	{
+		m_nodes.clear();
+		m_nodes.shrink_to_fit();
+		m_root = -1;
+	}
+
+	//! Swap with other sequence.
+	void swap( Sequence & other )
+	{
+		m_nodes.swap( other.m_nodes );
+		std::swap( m_root, other.m_root );
+		std::swap( m_seed, other.m_seed );
+	}
+
+	//! Replace items with \a items in O(n).
+	void assign( QVector< T > && items )
+	{
+		clear();
+
+		m_nodes.reserve( static_cast< size_t > ( items.size() ) );
+
+		// Cartesian tree of priorities is built on the right spine.
+		std::vector< int > spine;
+
+		for( auto & item : items )
+		{
+			const auto n = static_cast< int > ( m_nodes.size() );
+			m_nodes.push_back( { std::move( item ), -1, -1, nextPriority(), 1 } );
+
+			int last = -1;
+
+			while( !spine.empty() && m_nodes[ spine.back() ].m_priority < m_nodes[ n ].m_priority )
+			{
+				last = spine.back();
+				spine.pop_back();
+			}
+
+			m_nodes[ n ].m_left = last;
+
+			if( !spine.empty() )
+				m_nodes[ spine.back() ].m_right = n;
+
+			spine.push_back( n );
+		}
+
+		m_root = ( spine.empty() ? -1 : spine.front() );
+
+		updateSizes( m_root );
+	}
+
+	//! Append \a value in O(log n).
+	void push_back( T value )
+	{
+		const auto n = static_cast< int > ( m_nodes.size() );
+		m_nodes.push_back( { std::move( value ), -1, -1, nextPriority(), 1 } );
+
+		m_root = merge( m_root, n );
+	}
+
+	//! \return Item at \a pos.
+	const T & at( qsizetype pos ) const
+	{
+		return m_nodes[ find( pos ) ].m_value;
+	}
+
+	//! \return Item at \a pos.
+	T & operator [] ( qsizetype pos )
+	{
+		return m_nodes[ find( pos ) ].m_value;
+	}
+
+	/*!
+		Move \a count items starting at \a first, so they start at \a to
+		in the resulting sequence. \a to is in [0, size() - count].
+	*/
+	void move( qsizetype first, qsizetype count, qsizetype to )
+	{
+		if( count <= 0 || first < 0 || first + count > size() || to < 0 ||
+			to > size() - count || to == first )
+				return;
+
+		int head = -1, range = -1, tail = -1;
+
+		split( m_root, first, head, tail );
+		split( tail, count, range, tail );
+
+		const int rest = merge( head, tail );
+
+		split( rest, to, head, tail );
+
+		m_root = merge( merge( head, range ), tail );
+	}
+
+	//! \return Items in order in O(n).
+	QVector< T > toVector() const
+	{
+		QVector< T > items;
+		items.reserve( size() );
+
+		std::vector< int > stack;
+		int n = m_root;
+
+		while( n >= 0 || !stack.empty() )
+		{
+			while( n >= 0 )
+			{
+				stack.push_back( n );
+				n = m_nodes[ n ].m_left;
+			}
+
+			n = stack.back();
+			stack.pop_back();
+
+			items.push_back( m_nodes[ n ].m_value );
+
+			n = m_nodes[ n ].m_right;
+		}
+
+		return items;
+	}
+
+private:
+	//! \return Size of subtree.
+	qsizetype sizeOf( int n ) const
+	{
+		return ( n < 0 ? 0 : m_nodes[ n ].m_size );
+	}
+
+	//! Update size of node from its children.
+	void update( int n )
+	{
+		m_nodes[ n ].m_size = sizeOf( m_nodes[ n ].m_left ) + sizeOf( m_nodes[ n ].m_right ) + 1;
+	}
+
+	//! Update sizes of the whole subtree.
+	void updateSizes( int n )
+	{
+		if( n < 0 )
+			return;
+
+		updateSizes( m_nodes[ n ].m_left );
+		updateSizes( m_nodes[ n ].m_right );
+		update( n );
+	}
+
+	//! \return Node at \a pos.
+	int find( qsizetype pos ) const
+	{
+		Q_ASSERT( pos >= 0 && pos < size() );
+
+		int n = m_root;
+
+		while( true )
+		{
+			const auto left = sizeOf( m_nodes[ n ].m_left );
+
+			if( pos < left )
+				n = m_nodes[ n ].m_left;
+			else if( pos == left )
+				return n;
+			else
+			{
+				pos -= left + 1;
+				n = m_nodes[ n ].m_right;
+			}
+		}
+	}
+
+	//! Split \a n into the first \a count items in \a left and the rest in \a right.
+	void split( int n, qsizetype count, int & left, int & right )
+	{
+		if( n < 0 )
+		{
+			left = right = -1;
+
+			return;
+		}
+
+		if( sizeOf( m_nodes[ n ].m_left ) < count )
+		{
+			int r = -1;
+			split( m_nodes[ n ].m_right, count - sizeOf( m_nodes[ n ].m_left ) - 1,
+				m_nodes[ n ].m_right, r );
+			left = n;
+			right = r;
+		}
+		else
+		{
+			int l = -1;
+			split( m_nodes[ n ].m_left, count, l, m_nodes[ n ].m_left );
+			left = l;
+			right = n;
+		}
+
+		update( n );
+	}
+
+	//! \return Root of \a left followed by \a right.
+	int merge( int left, int right )
+	{
+		if( left < 0 )
+			return right;
+
+		if( right < 0 )
+			return left;
+
+		if( m_nodes[ left ].m_priority > m_nodes[ right ].m_priority )
+		{
+			const int r = merge( m_nodes[ left ].m_right, right );
+			m_nodes[ left ].m_right = r;
+			update( left );
+
+			return left;
+		}
+		else
+		{
+			const int l = merge( left, m_nodes[ right ].m_left );
+			m_nodes[ right ].m_left = l;
+			update( right );
+
+			return right;
+		}
+	}
+
+	//! \return Random priority.
+	quint32 nextPriority()
+	{
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+
+		return m_seed;
+	}
+
+private:
+	Q_DISABLE_COPY( Sequence )
+
+	//! Node.
+	struct Node {
+		//! Value.
+		T m_value;
+		//! Left child.
+		int m_left;
+		//! Right child.
+		int m_right;
+		//! Priority.
+		quint32 m_priority;
+		//! Size of subtree.
+		qsizetype m_size;
+	}; // struct Node
+
+	//! Nodes.
+	std::vector< Node > m_nodes;
+	//! Root.
+	int m_root;
+	//! State of random generator of priorities.
+	quint32 m_seed;
+}; // class Sequence
+
+#endif // GIF_EDITOR_CORE_SEQUENCE_HPP_INCLUDED
@@ -0,0 +1,113 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// GIF editor include.
+#include "similarity.hpp"
+#include "parallel.hpp"
+#include "progress.hpp"
+#include "trace.hpp"
+
+// C++ include.
+#include <cstdlib>
+
+
+namespace /* anonymous */ {
+
+//! Size of images compared for similarity.
+const int c_size = 64;
+//! Difference of channel that is noticeable.
+const int c_tolerance = 8;
+
+//! \return Frame reduced for comparison.
+QImage
+reduced( const FrameReader & frames, const FrameHandle & handle, const EditStack & edits )
+{
+	const auto img = frames.image( handle );
+	const auto size = edits.resultSize( img.size() ).scaled( c_size, c_size, Qt::KeepAspectRatio );
+
+	return edits.render( img, size.expandedTo( QSize( 1, 1 ) ) )
+		.convertToFormat( QImage::Format_ARGB32 );
+}
+
+} /* namespace anonymous */
+
+
+double
+imageDifference( const QImage & a, const QImage & b )
+{
+	if( a.size() != b.size() || a.format() != b.format() || a.isNull() )
+		return 1.0;
+
+	qint64 differ = 0;
+
+	for( int y = 0; y < a.height(); ++y )
+	{
+		const auto * la = reinterpret_cast< const QRgb* > ( a.constScanLine( y ) );
+		const auto * lb = reinterpret_cast< const QRgb* > ( b.constScanLine( y ) );
+
+		for( int x = 0; x < a.width(); ++x )
+		{
+			if( std::abs( qRed( la[ x ] ) - qRed( lb[ x ] ) ) > c_tolerance ||
+				std::abs( qGreen( la[ x ] ) - qGreen( lb[ x ] ) ) > c_tolerance ||
+				std::abs( qBlue( la[ x ] ) - qBlue( lb[ x ] ) ) > c_tolerance ||
+				std::abs( qAlpha( la[ x ] ) - qAlpha( lb[ x ] ) ) > c_tolerance )
+					++differ;
+		}
+	}
+
+	return (double) differ / ( (double) a.width() * a.height() );
+}
+
+QVector< double >
+frameDifferences( const FrameReader & frames, const QVector< FrameHandle > & handles,
+	const EditStack & edits, const CancellationToken & token, Progress * progress )
+{
+	TRACE_SPAN( "compare" );
+
+	const auto count = static_cast< int > ( handles.size() );
+	QVector< double > diffs( count, 1.0 );
+
+	if( progress )
+		progress->begin( Progress::Stage::Comparing, count );
+
+	// Both frames of a pair are reduced by the same worker, so reduced images
+	// are not kept for the whole document.
+	parallelFor( count,
+		[&] ( int i )
+		{
+			if( token.isCancelled() )
+				return;
+
+			if( i > 0 )
+				diffs[ i ] = imageDifference( reduced( frames, handles.at( i - 1 ), edits ),
+					reduced( frames, handles.at( i ), edits ) );
+
+			if( progress )
+				progress->add();
+		} );
+
+	if( token.isCancelled() )
+		return {};
+
+	return diffs;
+}
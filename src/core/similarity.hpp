@@ -0,0 +1,53 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_SIMILARITY_HPP_INCLUDED
+#define GIF_EDITOR_CORE_SIMILARITY_HPP_INCLUDED
+
+// GIF editor include.
+#include "cancellation.hpp"
+#include "framestore.hpp"
+#include "edits.hpp"
+
+// Qt include.
+#include <QImage>
+#include <QVector>
+
+
+class Progress;
+
+//! \return Share of pixels that differ in \a a and \a b of the same size and format.
+double imageDifference( const QImage & a, const QImage & b );
+
+/*!
+	\return Difference of every frame of \a handles with \a edits applied
+	from the previous frame, 1 for the first frame. Frames are compared
+	in reduced size. Frames are read with \a frames, so the store may
+	change meanwhile. Empty result if cancelled.
+*/
+QVector< double > frameDifferences( const FrameReader & frames,
+	const QVector< FrameHandle > & handles, const EditStack & edits,
+	const CancellationToken & token = CancellationToken(),
+	Progress * progress = nullptr );
+
+#endif // GIF_EDITOR_CORE_SIMILARITY_HPP_INCLUDED
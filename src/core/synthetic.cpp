@@ -0,0 +1,276 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "synthetic.hpp"
+
+// Qt include.
+#include <QColor>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QRect>
+
+// giflib include.
+#include <gif_lib.h>
+
+// C++ include.
+#include <vector>
+
+
+namespace /* anonymous */ {
+
+//! \return Color map, colors are shifted by \a shift to differ between frames.
+ColorMapObject *
+makePalette( int mapSize, int colors, int shift )
+{
+	std::vector< GifColorType > table( static_cast< size_t > ( mapSize ) );
+
+	for( int i = 0; i < colors; ++i )
+	{
+		const auto c = QColor::fromHsv( ( i * 360 / colors + shift * 7 ) % 360,
+			160 + ( i % 3 ) * 30, 255 - ( i % 5 ) * 30 );
+
+		table[ static_cast< size_t > ( i ) ].Red = static_cast< GifByteType > ( c.red() );
+		table[ static_cast< size_t > ( i ) ].Green = static_cast< GifByteType > ( c.green() );
+		table[ static_cast< size_t > ( i ) ].Blue = static_cast< GifByteType > ( c.blue() );
+	}
+
+	for( int i = colors; i < mapSize; ++i )
+		table[ static_cast< size_t > ( i ) ] = { 0, 0, 0 };
+
+	return GifMakeMapObject( mapSize, table.data() );
+}
+
+//! \return Order of rows, interlaced or not.
+std::vector< int >
+rowsOrder( int height, bool interlace )
+{
+	std::vector< int > rows;
+	rows.reserve( static_cast< size_t > ( height ) );
+
+	if( interlace )
+	{
+		static const int offsets[] = { 0, 4, 2, 1 };
+		static const int steps[] = { 8, 8, 4, 2 };
+
+		for( int pass = 0; pass < 4; ++pass )
+		{
+			for( int y = offsets[ pass ]; y < height; y += steps[ pass ] )
+				rows.push_back( y );
+		}
+	}
+	else
+	{
+		for( int y = 0; y < height; ++y )
+			rows.push_back( y );
+	}
+
+	return rows;
+}
+
+} /* namespace anonymous */
+
+
+bool
+writeSyntheticGif( const QString & fileName, const SyntheticOptions & opts, QString * error )
+{
+	auto fail = [error] ( const QString & msg )
+	{
+		if( error )
+			*error = msg;
+
+		return false;
+	};
+
+	const int w = opts.m_size.width();
+	const int h = opts.m_size.height();
+
+	if( w <= 0 || h <= 0 || w > 65535 || h > 65535 )
+		return fail( QStringLiteral( "Wrong size of canvas." ) );
+
+	if( opts.m_frames <= 0 )
+		return fail( QStringLiteral( "Wrong count of frames." ) );
+
+	if( opts.m_disposal < 0 || opts.m_disposal > 3 )
+		return fail( QStringLiteral( "Wrong disposal method." ) );
+
+	const int colors = qBound( 2, opts.m_paletteSize, 256 );
+	int bits = 1;
+
+	while( ( 1 << bits ) < colors )
+		++bits;
+
+	const int mapSize = 1 << bits;
+	// Transparent is the last color, picture uses colors below it.
+	const int transparent = ( opts.m_transparency ? colors - 1 : NO_TRANSPARENT_COLOR );
+	const int pictureColors = ( opts.m_transparency ? colors - 1 : colors );
+	const qint64 pixels = static_cast< qint64 > ( w ) * h;
+	const qint64 changes = qBound( Q_INT64_C( 0 ),
+		qRound64( qBound( 0.0, opts.m_change, 1.0 ) * pixels ), pixels );
+
+	QRandomGenerator rnd( opts.m_seed );
+
+	int err = 0;
+	GifFileType * gif = EGifOpenFileName( QFile::encodeName( fileName ).constData(),
+		false, &err );
+
+	if( !gif )
+		return fail( QString::fromLatin1( GifErrorString( err ) ) );
+
+	EGifSetGifVersion( gif, true );
+
+	auto close = [&gif, &err] () { EGifCloseFile( gif, &err ); gif = nullptr; };
+
+	ColorMapObject * global = ( opts.m_localPalettes ? nullptr :
+		makePalette( mapSize, colors, 0 ) );
+
+	const int screen = EGifPutScreenDesc( gif, w, h, bits, 0, global );
+
+	GifFreeMapObject( global );
+
+	if( screen == GIF_ERROR )
+	{
+		close();
+
+		return fail( QStringLiteral( "Unable to write screen descriptor." ) );
+	}
+
+	// Loop forever.
+	static const unsigned char loop[] = { 1, 0, 0 };
+
+	if( EGifPutExtensionLeader( gif, APPLICATION_EXT_FUNC_CODE ) == GIF_ERROR ||
+		EGifPutExtensionBlock( gif, 11, "NETSCAPE2.0" ) == GIF_ERROR ||
+		EGifPutExtensionBlock( gif, 3, loop ) == GIF_ERROR ||
+		EGifPutExtensionTrailer( gif ) == GIF_ERROR )
+	{
+		close();
+
+		return fail( QStringLiteral( "Unable to write loop extension." ) );
+	}
+
+	std::vector< GifPixelType > canvas( static_cast< size_t > ( pixels ) );
+	std::vector< bool > changed( static_cast< size_t > ( pixels ), false );
+	std::vector< GifPixelType > line( static_cast< size_t > ( w ) );
+
+	// Blocky base picture, compresses like UI.
+	for( int y = 0; y < h; ++y )
+	{
+		for( int x = 0; x < w; ++x )
+			canvas[ static_cast< size_t > ( y ) * w + x ] =
+				static_cast< GifPixelType > ( ( x / 16 + y / 16 ) % pictureColors );
+	}
+
+	for( int f = 0; f < opts.m_frames; ++f )
+	{
+		QRect box;
+
+		if( f == 0 )
+			box = QRect( 0, 0, w, h );
+		else if( changes == pixels )
+		{
+			for( qint64 i = 0; i < pixels; ++i )
+				canvas[ static_cast< size_t > ( i ) ] =
+					static_cast< GifPixelType > ( rnd.bounded( pictureColors ) );
+
+			std::fill( changed.begin(), changed.end(), true );
+
+			box = QRect( 0, 0, w, h );
+		}
+		else
+		{
+			for( qint64 i = 0; i < changes; ++i )
+			{
+				const auto idx = static_cast< qint64 > ( rnd.bounded( static_cast< quint64 > ( pixels ) ) );
+				const int x = static_cast< int > ( idx % w );
+				const int y = static_cast< int > ( idx / w );
+
+				canvas[ static_cast< size_t > ( idx ) ] =
+					static_cast< GifPixelType > ( rnd.bounded( pictureColors ) );
+				changed[ static_cast< size_t > ( idx ) ] = true;
+
+				box |= QRect( x, y, 1, 1 );
+			}
+
+			// Static frame still needs one pixel.
+			if( box.isEmpty() )
+				box = QRect( 0, 0, 1, 1 );
+		}
+
+		GraphicsControlBlock gcb;
+		gcb.DisposalMode = opts.m_disposal;
+		gcb.UserInputFlag = false;
+		gcb.DelayTime = qMax( 0, opts.m_delay / 10 );
+		gcb.TransparentColor = ( f > 0 ? transparent : NO_TRANSPARENT_COLOR );
+
+		GifByteType ext[ 4 ];
+		const auto extLen = EGifGCBToExtension( &gcb, ext );
+
+		ColorMapObject * local = ( opts.m_localPalettes ?
+			makePalette( mapSize, colors, f ) : nullptr );
+
+		const bool ok = ( EGifPutExtension( gif, GRAPHICS_EXT_FUNC_CODE,
+				static_cast< int > ( extLen ), ext ) != GIF_ERROR &&
+			EGifPutImageDesc( gif, box.x(), box.y(), box.width(), box.height(),
+				opts.m_interlace, local ) != GIF_ERROR );
+
+		GifFreeMapObject( local );
+
+		if( !ok )
+		{
+			close();
+
+			return fail( QStringLiteral( "Unable to write frame %1." ).arg( f + 1 ) );
+		}
+
+		for( const auto y : rowsOrder( box.height(), opts.m_interlace ) )
+		{
+			const size_t row = static_cast< size_t > ( box.y() + y ) * w;
+
+			for( int x = 0; x < box.width(); ++x )
+			{
+				const size_t idx = row + box.x() + x;
+
+				line[ static_cast< size_t > ( x ) ] =
+					( f > 0 && transparent != NO_TRANSPARENT_COLOR && !changed[ idx ] ?
+						static_cast< GifPixelType > ( transparent ) : canvas[ idx ] );
+			}
+
+			if( EGifPutLine( gif, line.data(), box.width() ) == GIF_ERROR )
+			{
+				close();
+
+				return fail( QStringLiteral( "Unable to write frame %1." ).arg( f + 1 ) );
+			}
+		}
+
+		for( int y = box.top(); y <= box.bottom(); ++y )
+		{
+			for( int x = box.left(); x <= box.right(); ++x )
+				changed[ static_cast< size_t > ( y ) * w + x ] = false;
+		}
+	}
+
+	if( EGifCloseFile( gif, &err ) == GIF_ERROR )
+		return fail( QString::fromLatin1( GifErrorString( err ) ) );
+
+	return true;
+}
@@ -0,0 +1,71 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_SYNTHETIC_HPP_INCLUDED
+#define GIF_EDITOR_CORE_SYNTHETIC_HPP_INCLUDED
+
+// Qt include.
+#include <QSize>
+#include <QString>
+
+
+//
+// SyntheticOptions
+//
+
+//! Parameters of synthetic GIF.
+struct SyntheticOptions final {
+	//! Size of canvas.
+	QSize m_size = QSize( 320, 240 );
+	//! Count of frames.
+	int m_frames = 10;
+	//! Fraction of pixels changing per frame, 0 - static, 1 - full-motion noise.
+	double m_change = 0.1;
+	//! Count of colors in palette, 2 - 256.
+	int m_paletteSize = 256;
+	//! Each frame has local color table instead of one global table.
+	bool m_localPalettes = false;
+	//! Unchanged pixels of frames are transparent.
+	bool m_transparency = false;
+	//! Disposal method, 0 - 3.
+	int m_disposal = 1;
+	//! Interlaced frames.
+	bool m_interlace = false;
+	//! Delay of frames in milliseconds.
+	int m_delay = 40;
+	//! Seed of random generator, the same seed gives the same GIF.
+	quint32 m_seed = 1;
+}; // struct SyntheticOptions
+
+/*!
+	Write deterministic GIF with the given parameters.
+
+	The first frame is a full canvas, the next frames cover only the bounding
+	rectangle of changed pixels, so small changes give small frames like
+	screen recordings and full changes give full-canvas noise.
+
+	\return Is GIF written? On error \a error is set if it isn't null.
+*/
+bool writeSyntheticGif( const QString & fileName, const SyntheticOptions & opts,
+	QString * error = nullptr );
+
+#endif // GIF_EDITOR_CORE_SYNTHETIC_HPP_INCLUDED
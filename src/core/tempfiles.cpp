@@ -0,0 +1,154 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "tempfiles.hpp"
+
+// Qt include.
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+
+namespace /* anonymous */ {
+
+//
+// Registry
+//
+
+//! Registered paths.
+struct Registry final {
+	//! Guard.
+	QMutex m_mutex;
+	//! Paths.
+	QSet< QString > m_paths;
+}; // struct Registry
+
+Registry &
+registry()
+{
+	static Registry r;
+
+	return r;
+}
+
+} /* namespace anonymous */
+
+
+//
+// TemporaryPath
+//
+
+TemporaryPath::TemporaryPath( const QString & path )
+	:	m_path( path )
+{
+	TemporaryFiles::add( m_path );
+}
+
+TemporaryPath::~TemporaryPath()
+{
+	TemporaryFiles::remove( m_path );
+}
+
+
+//
+// TemporaryFiles
+//
+
+void
+TemporaryFiles::add( const QString & path )
+{
+	auto & r = registry();
+
+	QMutexLocker lock( &r.m_mutex );
+
+	r.m_paths.insert( path );
+}
+
+void
+TemporaryFiles::add( const QStringList & paths )
+{
+	auto & r = registry();
+
+	QMutexLocker lock( &r.m_mutex );
+
+	for( const auto & path : paths )
+		r.m_paths.insert( path );
+}
+
+void
+TemporaryFiles::remove( const QString & path )
+{
+	auto & r = registry();
+
+	QMutexLocker lock( &r.m_mutex );
+
+	r.m_paths.remove( path );
+}
+
+void
+TemporaryFiles::remove( const QStringList & paths )
+{
+	auto & r = registry();
+
+	QMutexLocker lock( &r.m_mutex );
+
+	for( const auto & path : paths )
+		r.m_paths.remove( path );
+}
+
+void
+TemporaryFiles::removeAll()
+{
+	QSet< QString > paths;
+
+	{
+		auto & r = registry();
+
+		QMutexLocker lock( &r.m_mutex );
+
+		paths.swap( r.m_paths );
+	}
+
+	QSet< QString > parents;
+
+	for( const auto & path : std::as_const( paths ) )
+	{
+		const QFileInfo info( path );
+
+		if( info.isDir() )
+			QDir( path ).removeRecursively();
+		else
+		{
+			QFile::remove( path );
+
+			parents.insert( info.absolutePath() );
+		}
+	}
+
+	// Only empty directories are removed.
+	for( const auto & parent : std::as_const( parents ) )
+		QDir().rmdir( parent );
+}
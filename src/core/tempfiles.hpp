@@ -0,0 +1,79 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_TEMPFILES_HPP_INCLUDED
+#define GIF_EDITOR_CORE_TEMPFILES_HPP_INCLUDED
+
+// Qt include.
+#include <QString>
+#include <QStringList>
+
+
+//
+// TemporaryFiles
+//
+
+/*!
+	Registry of temporary files and directories of work in progress.
+
+	Quit doesn't wait for work that can't be interrupted, e.g. encoding
+	in qgiflib, so its files are removed through the registry before exit.
+	All methods are thread-safe.
+*/
+class TemporaryFiles final {
+public:
+	//! Register file or directory.
+	static void add( const QString & path );
+	//! Register files.
+	static void add( const QStringList & paths );
+	//! Unregister file or directory.
+	static void remove( const QString & path );
+	//! Unregister files.
+	static void remove( const QStringList & paths );
+
+	/*!
+		Remove all registered files and directories, directories are
+		removed recursively and parent directories of files if they became
+		empty. On POSIX a file is removed even if it's still written.
+	*/
+	static void removeAll();
+}; // class TemporaryFiles
+
+
+//
+// TemporaryPath
+//
+
+//! Registration of temporary file or directory for the lifetime of the object.
+class TemporaryPath final {
+public:
+	explicit TemporaryPath( const QString & path );
+	~TemporaryPath();
+
+private:
+	Q_DISABLE_COPY( TemporaryPath )
+
+	//! Path.
+	QString m_path;
+}; // class TemporaryPath
+
+#endif // GIF_EDITOR_CORE_TEMPFILES_HPP_INCLUDED
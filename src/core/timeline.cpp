@@ -0,0 +1,131 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// GIF editor include.
+#include "timeline.hpp"
+
+
+//
+// Timeline
+//
+
+Timeline::Timeline()
+	:	m_total( 0 )
+	,	m_step( 0 )
+{
+}
+
+void
+Timeline::reset( const QVector< qint64 > & durations )
+{
+	const auto n = static_cast< int > ( durations.size() );
+
+	m_durations = durations;
+	m_tree.fill( 0, n + 1 );
+	m_total = 0;
+
+	// Every node passes its sum to the parent, O(n).
+	for( int i = 1; i <= n; ++i )
+	{
+		m_tree[ i ] += durations.at( i - 1 );
+		m_total += durations.at( i - 1 );
+
+		const int parent = i + ( i & -i );
+
+		if( parent <= n )
+			m_tree[ parent ] += m_tree.at( i );
+	}
+
+	m_step = 1;
+
+	while( m_step * 2 <= n )
+		m_step *= 2;
+
+	if( !n )
+		m_step = 0;
+}
+
+int
+Timeline::count() const
+{
+	return static_cast< int > ( m_durations.size() );
+}
+
+qint64
+Timeline::duration( int idx ) const
+{
+	return m_durations.at( idx );
+}
+
+void
+Timeline::setDuration( int idx, qint64 value )
+{
+	const auto delta = value - m_durations.at( idx );
+
+	if( !delta )
+		return;
+
+	m_durations[ idx ] = value;
+	m_total += delta;
+
+	for( int i = idx + 1; i <= count(); i += ( i & -i ) )
+		m_tree[ i ] += delta;
+}
+
+qint64
+Timeline::start( int idx ) const
+{
+	qint64 sum = 0;
+
+	for( int i = qMin( idx, count() ); i > 0; i -= ( i & -i ) )
+		sum += m_tree.at( i );
+
+	return sum;
+}
+
+qint64
+Timeline::total() const
+{
+	return m_total;
+}
+
+int
+Timeline::at( qint64 t ) const
+{
+	if( t < 0 || t >= m_total )
+		return -1;
+
+	// Binary lifting: the longest prefix with sum not greater than t.
+	int pos = 0;
+
+	for( int step = m_step; step > 0; step /= 2 )
+	{
+		if( pos + step <= count() && m_tree.at( pos + step ) <= t )
+		{
+			pos += step;
+			t -= m_tree.at( pos );
+		}
+	}
+
+	return pos;
+}
@@ -0,0 +1,77 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_TIMELINE_HPP_INCLUDED
+#define GIF_EDITOR_CORE_TIMELINE_HPP_INCLUDED
+
+// Qt include.
+#include <QVector>
+
+
+//! The shortest delay of frame in milliseconds, shorter delays are clamped.
+const int c_minFrameDelay = 10;
+
+//
+// Timeline
+//
+
+/*!
+	Durations of items with prefix sums in Fenwick tree.
+
+	Change of duration, start of item and search of item at time are
+	O(log n), building is O(n). Items of zero duration take no time
+	on the timeline and are never found by at().
+*/
+class Timeline final {
+public:
+	Timeline();
+
+	//! Build timeline of \a durations.
+	void reset( const QVector< qint64 > & durations );
+
+	//! \return Count of items.
+	int count() const;
+	//! \return Duration of item.
+	qint64 duration( int idx ) const;
+	//! Set duration of item.
+	void setDuration( int idx, qint64 value );
+
+	//! \return Start of item, i.e. sum of durations of items before it.
+	qint64 start( int idx ) const;
+	//! \return Sum of all durations.
+	qint64 total() const;
+	//! \return Item that runs at time \a t, -1 if \a t is out of timeline.
+	int at( qint64 t ) const;
+
+private:
+	//! Fenwick tree, indexed from 1.
+	QVector< qint64 > m_tree;
+	//! Durations.
+	QVector< qint64 > m_durations;
+	//! Sum of all durations.
+	qint64 m_total;
+	//! The greatest power of two not greater than count.
+	int m_step;
+}; // class Timeline
+
+#endif // GIF_EDITOR_CORE_TIMELINE_HPP_INCLUDED
@@ -0,0 +1,258 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "trace.hpp"
+
+// Qt include.
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QSaveFile>
+
+// C++ include.
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace /* anonymous */ {
+
+//! Complete event.
+struct Event final {
+	//! Name.
+	const char * m_name;
+	//! Start in microseconds.
+	qint64 m_start;
+	//! Duration in microseconds.
+	qint64 m_duration;
+}; // struct Event
+
+//! Events of one thread.
+struct ThreadBuffer final {
+	//! Only the owner thread and stop() lock it, so it's uncontended.
+	QMutex m_mutex;
+	//! Events.
+	std::vector< Event > m_events;
+	//! Thread id in trace.
+	int m_tid = 0;
+	//! Thread name.
+	QString m_name;
+}; // struct ThreadBuffer
+
+//! All buffers.
+struct Registry final {
+	//! Mutex.
+	QMutex m_mutex;
+	//! Buffers, live until exit because threads keep pointers to them.
+	std::vector< std::unique_ptr< ThreadBuffer > > m_buffers;
+	//! Trace file.
+	QString m_fileName;
+	//! Start of tracing.
+	std::chrono::steady_clock::time_point m_start;
+	//! Thread that started tracing.
+	std::thread::id m_mainThread;
+}; // struct Registry
+
+Registry &
+registry()
+{
+	static Registry r;
+
+	return r;
+}
+
+//! \return Buffer of the current thread.
+ThreadBuffer *
+threadBuffer()
+{
+	thread_local ThreadBuffer * buffer = nullptr;
+
+	if( !buffer )
+	{
+		auto & r = registry();
+
+		QMutexLocker lock( &r.m_mutex );
+
+		r.m_buffers.push_back( std::make_unique< ThreadBuffer > () );
+		buffer = r.m_buffers.back().get();
+		buffer->m_tid = static_cast< int > ( r.m_buffers.size() );
+
+		if( std::this_thread::get_id() == r.m_mainThread )
+			buffer->m_name = QStringLiteral( "main" );
+		else
+		{
+			const auto name = QThread::currentThread()->objectName();
+
+			buffer->m_name = QStringLiteral( "%1 %2" )
+				.arg( name.isEmpty() ? QStringLiteral( "thread" ) : name )
+				.arg( buffer->m_tid );
+		}
+	}
+
+	return buffer;
+}
+
+//! \return String escaped for JSON.
+QByteArray
+escaped( const QString & s )
+{
+	QByteArray res = s.toUtf8();
+	res.replace( '\\', "\\\\" );
+	res.replace( '"', "\\\"" );
+
+	return res;
+}
+
+} /* namespace anonymous */
+
+
+//
+// Trace
+//
+
+std::atomic< bool > Trace::s_enabled( false );
+
+void
+Trace::start( const QString & fileName )
+{
+	auto & r = registry();
+
+	{
+		QMutexLocker lock( &r.m_mutex );
+
+		r.m_fileName = fileName;
+		r.m_start = std::chrono::steady_clock::now();
+		r.m_mainThread = std::this_thread::get_id();
+
+		for( auto & b : r.m_buffers )
+		{
+			QMutexLocker bufferLock( &b->m_mutex );
+
+			b->m_events.clear();
+		}
+	}
+
+	s_enabled.store( true, std::memory_order_release );
+}
+
+bool
+Trace::stop()
+{
+	if( !s_enabled.exchange( false ) )
+		return false;
+
+	auto & r = registry();
+
+	QMutexLocker lock( &r.m_mutex );
+
+	QSaveFile file( r.m_fileName );
+
+	if( !file.open( QIODevice::WriteOnly ) )
+		return false;
+
+	file.write( "{\"traceEvents\":[\n" );
+
+	bool first = true;
+
+	auto separator = [&] ()
+	{
+		if( !first )
+			file.write( ",\n" );
+
+		first = false;
+	};
+
+	for( auto & b : r.m_buffers )
+	{
+		QMutexLocker bufferLock( &b->m_mutex );
+
+		separator();
+		file.write( QByteArray( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" ) +
+			QByteArray::number( b->m_tid ) + ",\"args\":{\"name\":\"" +
+			escaped( b->m_name ) + "\"}}" );
+
+		for( const auto & e : b->m_events )
+		{
+			separator();
+			file.write( QByteArray( "{\"name\":\"" ) + e.m_name +
+				"\",\"cat\":\"gif-editor\",\"ph\":\"X\",\"ts\":" +
+				QByteArray::number( e.m_start ) + ",\"dur\":" +
+				QByteArray::number( e.m_duration ) + ",\"pid\":1,\"tid\":" +
+				QByteArray::number( b->m_tid ) + "}" );
+		}
+
+		b->m_events.clear();
+	}
+
+	file.write( "\n]}\n" );
+
+	return file.commit();
+}
+
+qint64
+Trace::now()
+{
+	return std::chrono::duration_cast< std::chrono::microseconds > (
+		std::chrono::steady_clock::now() - registry().m_start ).count();
+}
+
+void
+Trace::add( const char * name, qint64 start, qint64 duration )
+{
+	auto * b = threadBuffer();
+
+	QMutexLocker lock( &b->m_mutex );
+
+	b->m_events.push_back( { name, start, duration } );
+}
+
+
+//
+// TraceSession
+//
+
+TraceSession::TraceSession( int argc, char ** argv )
+{
+	QString fileName = QString::fromLocal8Bit( qgetenv( "GIF_EDITOR_TRACE" ) );
+
+	static const char * option = "--trace";
+	const auto length = std::strlen( option );
+
+	for( int i = 1; i < argc; ++i )
+	{
+		if( std::strcmp( argv[ i ], option ) == 0 && i + 1 < argc )
+			fileName = QString::fromLocal8Bit( argv[ i + 1 ] );
+		else if( std::strncmp( argv[ i ], option, length ) == 0 && argv[ i ][ length ] == '=' )
+			fileName = QString::fromLocal8Bit( argv[ i ] + length + 1 );
+	}
+
+	if( !fileName.isEmpty() )
+		Trace::start( fileName );
+}
+
+TraceSession::~TraceSession()
+{
+	Trace::stop();
+}
@@ -0,0 +1,153 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_CORE_TRACE_HPP_INCLUDED
+#define GIF_EDITOR_CORE_TRACE_HPP_INCLUDED
+
+// Qt include.
+#include <QString>
+
+// C++ include.
+#include <atomic>
+
+
+//
+// Trace
+//
+
+/*!
+	Tracing of long-running operations.
+
+	Spans are collected into per-thread buffers and written on stop()
+	as Chrome trace event JSON, that can be opened in chrome://tracing
+	or Perfetto. While tracing is off a span costs one relaxed atomic load
+	and remembering of its name as the current span of the thread.
+*/
+class Trace final {
+public:
+	//! Start tracing, trace will be written to \a fileName.
+	static void start( const QString & fileName );
+	//! Stop tracing and write trace. \return Is trace written?
+	static bool stop();
+
+	//! \return Is tracing on?
+	static bool isEnabled()
+	{
+		return s_enabled.load( std::memory_order_relaxed );
+	}
+
+	//! \return Span running on the current thread, null if none.
+	static const char *& current()
+	{
+		thread_local const char * span = nullptr;
+
+		return span;
+	}
+
+	//! \return The last started span of the current thread, null if none.
+	static const char *& last()
+	{
+		thread_local const char * span = nullptr;
+
+		return span;
+	}
+
+	//! \return Microseconds since start of tracing.
+	static qint64 now();
+	//! Add span of the current thread.
+	static void add( const char * name, qint64 start, qint64 duration );
+
+private:
+	//! Is tracing on?
+	static std::atomic< bool > s_enabled;
+}; // class Trace
+
+
+//
+// TraceSpan
+//
+
+//! Span that lasts until end of the scope.
+class TraceSpan final {
+public:
+	//! \a name should live until trace is written, string literal is expected.
+	explicit TraceSpan( const char * name )
+		:	m_name( name )
+		,	m_parent( Trace::current() )
+		,	m_start( Trace::isEnabled() ? Trace::now() : -1 )
+	{
+		Trace::current() = name;
+		Trace::last() = name;
+	}
+
+	~TraceSpan()
+	{
+		Trace::current() = m_parent;
+
+		if( m_start >= 0 )
+			Trace::add( m_name, m_start, Trace::now() - m_start );
+	}
+
+private:
+	Q_DISABLE_COPY( TraceSpan )
+
+	//! Name.
+	const char * m_name;
+	//! Enclosing span.
+	const char * m_parent;
+	//! Start, -1 if tracing was off.
+	qint64 m_start;
+}; // class TraceSpan
+
+
+//
+// TraceSession
+//
+
+/*!
+	Tracing for the lifetime of the object.
+
+	Tracing is on if "--trace <file>" or "--trace=<file>" is in arguments,
+	or GIF_EDITOR_TRACE environment variable is set to the file name.
+*/
+class TraceSession final {
+public:
+	TraceSession( int argc, char ** argv );
+	~TraceSession();
+
+private:
+	Q_DISABLE_COPY( TraceSession )
+}; // class TraceSession
+
+
+#ifdef GIF_EDITOR_WITH_TRACE
+	#define GIF_EDITOR_TRACE_CONCAT_( a, b ) a##b
+	#define GIF_EDITOR_TRACE_CONCAT( a, b ) GIF_EDITOR_TRACE_CONCAT_( a, b )
+
+	//! Trace the rest of the scope as \a name.
+	#define TRACE_SPAN( name ) \
+		const TraceSpan GIF_EDITOR_TRACE_CONCAT( traceSpan, __LINE__ ) ( name )
+#else
+	#define TRACE_SPAN( name ) do {} while( false )
+#endif
+
+#endif // GIF_EDITOR_CORE_TRACE_HPP_INCLUDED
@@ -0,0 +1,200 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// GIF editor include.
+#include "watchdog.hpp"
+#include "metrics.hpp"
+#include "trace.hpp"
+
+// Qt include.
+#include <QObject>
+#include <QEvent>
+#include <QMetaEnum>
+#include <QStringList>
+
+
+namespace /* anonymous */ {
+
+//! \return Name of event's type.
+QByteArray
+eventName( int type )
+{
+	const char * key = QMetaEnum::fromType< QEvent::Type > ().valueToKey( type );
+
+	return ( key ? QByteArray( key ) : QByteArray::number( type ) );
+}
+
+} /* namespace anonymous */
+
+
+//
+// Watchdog
+//
+
+const qint64 Watchdog::c_defaultThreshold;
+
+Watchdog::Watchdog( qint64 threshold )
+	:	m_threshold( qMax( Q_INT64_C( 0 ), threshold ) * 1000000 )
+	,	m_last( 0 )
+	,	m_idle( false )
+{
+	m_clock.start();
+	m_stack.reserve( 16 );
+}
+
+qint64
+Watchdog::threshold() const
+{
+	return m_threshold / 1000000;
+}
+
+void
+Watchdog::setThreshold( qint64 msecs )
+{
+	m_threshold = qMax( Q_INT64_C( 0 ), msecs ) * 1000000;
+}
+
+void
+Watchdog::enter( const QObject * receiver, const QEvent * event )
+{
+	if( !m_threshold )
+		return;
+
+	check( m_clock.nsecsElapsed() );
+
+	Dispatch d;
+	d.m_receiver = ( receiver ? receiver->metaObject()->className() : "null" );
+	d.m_type = static_cast< int > ( event->type() );
+
+	m_stack.push_back( d );
+}
+
+void
+Watchdog::leave()
+{
+	if( !m_threshold || m_stack.empty() )
+		return;
+
+	check( m_clock.nsecsElapsed() );
+
+	m_stack.pop_back();
+}
+
+void
+Watchdog::idle()
+{
+	if( !m_threshold )
+		return;
+
+	check( m_clock.nsecsElapsed() );
+
+	m_idle = true;
+}
+
+void
+Watchdog::awake()
+{
+	m_idle = false;
+	m_last = m_clock.nsecsElapsed();
+	Trace::last() = nullptr;
+}
+
+void
+Watchdog::check( qint64 now )
+{
+	const auto busy = now - m_last;
+
+	m_last = now;
+
+	if( m_idle )
+	{
+		m_idle = false;
+
+		return;
+	}
+
+	if( busy >= m_threshold )
+	{
+		const auto msecs = busy / 1000000;
+		auto & m = Metrics::instance();
+
+		int bucket = 0;
+
+		while( bucket < Metrics::c_stallBuckets - 1 && msecs >= Metrics::c_stallBounds[ bucket ] )
+			++bucket;
+
+		Metrics::add( m.m_stalls[ bucket ] );
+
+		if( msecs > Metrics::get( m.m_maxStallMsecs ) )
+			Metrics::set( m.m_maxStallMsecs, msecs );
+
+		const char * span = ( Trace::current() ? Trace::current() : Trace::last() );
+
+		if( m_stack.empty() )
+			qWarning( "UI stall of %lld ms in event loop, span \"%s\".",
+				msecs, span ? span : "none" );
+		else
+			qWarning( "UI stall of %lld ms in %s to %s, span \"%s\".",
+				msecs, eventName( m_stack.back().m_type ).constData(),
+				m_stack.back().m_receiver, span ? span : "none" );
+	}
+
+	Trace::last() = nullptr;
+}
+
+QString
+Watchdog::summary()
+{
+	const auto & m = Metrics::instance();
+	QStringList buckets;
+	qint64 count = 0;
+	qint64 from = 0;
+
+	for( int i = 0; i < Metrics::c_stallBuckets; ++i )
+	{
+		const auto n = Metrics::get( m.m_stalls[ i ] );
+
+		count += n;
+
+		if( n )
+		{
+			if( i == 0 )
+				buckets.append( QStringLiteral( "< %1 ms: %2" )
+					.arg( Metrics::c_stallBounds[ i ] ).arg( n ) );
+			else if( Metrics::c_stallBounds[ i ] > 0 )
+				buckets.append( QStringLiteral( "%1-%2 ms: %3" ).arg( from )
+					.arg( Metrics::c_stallBounds[ i ] ).arg( n ) );
+			else
+				buckets.append( QStringLiteral( ">= %1 ms: %2" ).arg( from ).arg( n ) );
+		}
+
+		from = Metrics::c_stallBounds[ i ];
+	}
+
+	if( !count )
+		return QString();
+
+	return QStringLiteral( "%1 UI stalls, the longest %2 ms (%3)." )
+		.arg( count ).arg( Metrics::get( m.m_maxStallMsecs ) )
+		.arg( buckets.join( QStringLiteral( ", " ) ) );
+}
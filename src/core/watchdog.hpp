@@ -0,0 +1,104 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef GIF_EDITOR_CORE_WATCHDOG_HPP_INCLUDED
+#define GIF_EDITOR_CORE_WATCHDOG_HPP_INCLUDED
+
+// Qt include.
+#include <QElapsedTimer>
+#include <QString>
+
+// C++ include.
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+class QObject;
+class QEvent;
+QT_END_NAMESPACE
+
+
+//
+// Watchdog
+//
+
+/*!
+	Watchdog of stalls of an event loop.
+
+	A stall is the time the thread was busy without dispatching of any event,
+	i.e. the time user could not interact with the application. Time spent
+	in waiting for events is not counted, and processEvents() inside of a long
+	loop splits the loop into short stalls. Every stall longer than the threshold
+	is logged with the event being handled and the running tracing span, and is
+	counted in Metrics. Should be used on one thread.
+*/
+class Watchdog final {
+public:
+	//! Default threshold in milliseconds.
+	static const qint64 c_defaultThreshold = 50;
+
+	explicit Watchdog( qint64 threshold = c_defaultThreshold );
+
+	//! \return Threshold in milliseconds, 0 if disabled.
+	qint64 threshold() const;
+	//! Set threshold in milliseconds, 0 disables.
+	void setThreshold( qint64 msecs );
+
+	//! Dispatch of \a event to \a receiver starts.
+	void enter( const QObject * receiver, const QEvent * event );
+	//! Dispatch of the last entered event finished.
+	void leave();
+	//! Event loop is going to wait for events.
+	void idle();
+	//! Event loop woke up.
+	void awake();
+
+	//! \return Histogram of stalls of the session, empty if there were no stalls.
+	static QString summary();
+
+private:
+	Q_DISABLE_COPY( Watchdog )
+
+	//! Finish busy interval at \a now, log it if it's a stall.
+	void check( qint64 now );
+
+	//! Dispatched event.
+	struct Dispatch final {
+		//! Class of receiver.
+		const char * m_receiver = nullptr;
+		//! Type of event.
+		int m_type = 0;
+	}; // struct Dispatch
+
+	//! Threshold in nanoseconds.
+	qint64 m_threshold;
+	//! Clock.
+	QElapsedTimer m_clock;
+	//! Start of the current busy interval in nanoseconds.
+	qint64 m_last;
+	//! Is event loop waiting for events?
+	bool m_idle;
+	//! Nested dispatches.
+	std::vector< Dispatch > m_stack;
+}; // class Watchdog
+
+#endif // GIF_EDITOR_CORE_WATCHDOG_HPP_INCLUDED
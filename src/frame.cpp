@@ -22,14 +22,19 @@
 
 // GIF editor include.
 #include "frame.hpp"
+#include "core/trace.hpp"
+#include "core/metrics.hpp"
+#include "core/job.hpp"
 
 // Qt include.
+#include <QTimer>
+#include <QElapsedTimer>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QMouseEvent>
-#include <QThreadPool>
-#include <QApplication>
-#include <QRunnable>
+
+// C++ include.
+#include <memory>
 
 
 //
@@ -45,10 +50,20 @@ public:
 		,	m_dirty( false )
 		,	q( parent )
 	{
+		m_refine.setSingleShot( true );
+	}
+
+	~FramePrivate()
+	{
+		Metrics::add( Metrics::instance().m_thumbnailBytes, -m_thumbnail.sizeInBytes() );
 	}
 
-	//! Create thumbnail.
+	//! Create thumbnail asynchronously.
 	void createThumbnail( int height );
+	//! Render the latest requested image of current frame.
+	void renderCurrent();
+	//! Set thumbnail.
+	void setThumbnail( const QImage & img );
 	//! Frame widget was resized.
 	void resized( int height = -1 );
 
@@ -66,50 +81,29 @@ public:
 	int m_height = 0;
 	//! Desired height.
 	int m_desiredHeight = -1;
+	//! Job creating thumbnail.
+	Job * m_job = nullptr;
+	//! Is render of current frame requested?
+	bool m_renderRequested = false;
+	//! Quality of shown image.
+	Frame::Quality m_quality = Frame::Quality::None;
+	//! Timer of refinement of preview.
+	QTimer m_refine;
+	//! Time since the last preview.
+	QElapsedTimer m_lastPreview;
 	//! Parent.
 	Frame * q;
 }; // class FramePrivate
 
-class ThumbnailCreator final
-	:	public QRunnable
+void
+FramePrivate::setThumbnail( const QImage & img )
 {
-public:
-	ThumbnailCreator( QImage img, int width, int height, int desiredHeight,
-		Frame::ResizeMode mode )
-		:	m_img( img )
-		,	m_width( width )
-		,	m_height( height )
-		,	m_desiredHeight( desiredHeight )
-		,	m_mode( mode )
-	{
-		setAutoDelete( false );
-	}
+	Metrics::add( Metrics::instance().m_thumbnailBytes,
+		img.sizeInBytes() - m_thumbnail.sizeInBytes() );
 
-	const QImage & image() const
-	{
-		return m_thumbnail;
-	}
-
-	void run() override
-	{
-		if( m_img.width() > m_width || m_img.height() > m_height )
-		{
-			m_thumbnail = m_img.scaledToHeight(
-				m_desiredHeight > 0 ? m_desiredHeight : m_height,
-				Qt::SmoothTransformation );
-		}
-		else
-			m_thumbnail = m_img;
-	}
-
-private:
-	QImage m_img;
-	int m_width;
-	int m_height;
-	int m_desiredHeight;
-	Frame::ResizeMode m_mode;
-	QImage m_thumbnail;
-};
+	m_thumbnail = img;
+	m_quality = ( img.isNull() ? Frame::Quality::None : Frame::Quality::Full );
+}
 
 void
 FramePrivate::createThumbnail( int height )
@@ -122,33 +116,108 @@ FramePrivate::createThumbnail( int height )
 		m_width = q->width();
 		m_desiredHeight = height;
 
+		const auto size = m_image.m_doc.imageSize();
+
 		if( m_mode == Frame::ResizeMode::FitToHeight )
 		{
-			ThumbnailCreator c( m_image.m_gif.at( m_image.m_pos ), q->width(), q->height(),
-				height, m_mode );
+			QSize target = size;
+
+			if( size.width() > m_width || size.height() > m_height )
+			{
+				const int h = ( height > 0 ? height : m_height );
+
+				target = QSize( qMax( 1, qRound( (double) size.width() * h / (double) size.height() ) ),
+					h );
+			}
+
+			// Job gets a reader and copies, so document may change while thumbnail is rendered.
+			const auto frames = m_image.m_doc.frames().reader();
+			const auto handle = m_image.m_doc.frames().handle( m_image.m_pos );
+			const auto edits = m_image.m_doc.edits();
+			auto thumbnail = std::make_shared< QImage > ();
+
+			if( !m_job )
+				m_job = new Job( q );
 
-			QThreadPool::globalInstance()->start( &c );
+			m_job->start(
+				[frames, handle, edits, target, thumbnail] ( const JobControl & job )
+				{
+					TRACE_SPAN( "thumbnail" );
 
-			while( !QThreadPool::globalInstance()->waitForDone( 5 ) )
-				QApplication::processEvents();
+					if( job.isCancelled() )
+						return false;
 
-			m_thumbnail = c.image();
+					*thumbnail = edits.render( frames.image( handle ), target );
+
+					return true;
+				},
+				[this, thumbnail] ( Job::Result result )
+				{
+					if( result == Job::Result::Succeeded )
+					{
+						setThumbnail( *thumbnail );
+
+						q->updateGeometry();
+
+						emit q->resized();
+
+						q->update();
+					}
+				},
+				Scheduler::Priority::Thumbnail );
 		}
-		else
+		else if( !m_renderRequested )
 		{
-			const auto img = m_image.m_gif.at( m_image.m_pos );
+			// Requests of one pass of event loop are coalesced, only the latest is rendered.
+			m_renderRequested = true;
 
-			if( img.width() > q->width() || img.height() > q->height() )
-			{
-				m_thumbnail = img.scaled( q->width(), q->height(),
-					Qt::KeepAspectRatio, Qt::SmoothTransformation );
-			}
-			else
-				m_thumbnail = img;
+			QTimer::singleShot( 0, q, [this] () { renderCurrent(); } );
 		}
 	}
 }
 
+void
+FramePrivate::renderCurrent()
+{
+	if( !m_renderRequested || m_image.m_isEmpty )
+		return;
+
+	m_renderRequested = false;
+
+	const auto frames = m_image.m_doc.frames().reader();
+	const auto handle = m_image.m_doc.frames().handle( m_image.m_pos );
+	const auto edits = m_image.m_doc.edits();
+	const auto target = q->fitSize();
+	auto img = std::make_shared< QImage > ();
+
+	if( !m_job )
+		m_job = new Job( q );
+
+	// Starting of job cancels a stale render, its result is dropped.
+	m_job->start(
+		[frames, handle, edits, target, img] ( const JobControl & job )
+		{
+			TRACE_SPAN( "render" );
+
+			if( job.isCancelled() )
+				return false;
+
+			*img = edits.render( frames.image( handle ), target );
+
+			return !job.isCancelled();
+		},
+		[this, img] ( Job::Result result )
+		{
+			if( result == Job::Result::Succeeded )
+			{
+				setThumbnail( *img );
+
+				q->update();
+			}
+		},
+		Scheduler::Priority::Interactive );
+}
+
 void
 FramePrivate::resized( int height )
 {
@@ -168,10 +237,19 @@ FramePrivate::resized( int height )
 // Frame
 //
 
+const int Frame::c_refineDelay;
+
 Frame::Frame( const ImageRef & img, ResizeMode mode, QWidget * parent, int height )
 	:	QWidget( parent )
 	,	d( new FramePrivate( img, mode, this ) )
 {
+	connect( &d->m_refine, &QTimer::timeout, this,
+		[this] ()
+		{
+			d->m_renderRequested = true;
+			d->renderCurrent();
+		} );
+
 	switch( mode )
 	{
 		case ResizeMode::FitToSize :
@@ -206,11 +284,23 @@ Frame::setImagePos( qsizetype pos )
 	d->m_height = 0;
 }
 
+void
+Frame::moveImage( qsizetype pos )
+{
+	d->m_image.m_pos = pos;
+}
+
 void
 Frame::clearImage()
 {
 	d->m_image.m_isEmpty = true;
-	d->m_thumbnail = QImage();
+	d->m_renderRequested = false;
+	d->m_refine.stop();
+
+	if( d->m_job )
+		d->m_job->cancel();
+
+	d->setThumbnail( QImage() );
 	d->m_desiredHeight = -1;
 	d->m_width = 0;
 	d->m_height = 0;
@@ -227,27 +317,90 @@ Frame::applyImage()
 	update();
 }
 
-QRect
-Frame::thumbnailRect() const
+void
+Frame::setImage( qsizetype pos, const QImage & thumbnail )
 {
-	const int x = ( width() - d->m_thumbnail.width() ) / 2;
-	const int y = ( height() - d->m_thumbnail.height() ) / 2;
+	d->m_renderRequested = false;
+	d->m_refine.stop();
 
-	QRect r = d->m_thumbnail.rect();
-	r.moveTopLeft( QPoint( x, y ) );
+	if( d->m_job )
+		d->m_job->cancel();
 
-	return r;
+	d->m_image.m_pos = pos;
+	d->m_image.m_isEmpty = false;
+	d->m_dirty = false;
+	d->m_desiredHeight = -1;
+	d->m_width = width();
+	d->m_height = height();
+	d->setThumbnail( thumbnail );
+
+	update();
+}
+
+void
+Frame::setPreview( qsizetype pos, const QImage & preview )
+{
+	setImage( pos, preview );
+
+	d->m_quality = Quality::Preview;
+
+	// Previews that follow each other quickly mean scrubbing, refine only when it stops.
+	const bool scrubbing = d->m_lastPreview.isValid() &&
+		d->m_lastPreview.elapsed() < c_refineDelay;
+
+	d->m_lastPreview.start();
+	d->m_refine.start( scrubbing ? c_refineDelay : 0 );
+}
+
+Frame::Quality
+Frame::quality() const
+{
+	return d->m_quality;
+}
+
+QImage
+Frame::thumbnail() const
+{
+	return ( d->m_dirty ? QImage() : d->m_thumbnail );
+}
+
+QSize
+Frame::fitSize() const
+{
+	const auto imageSize = d->m_image.m_doc.imageSize();
+
+	if( imageSize.width() > width() || imageSize.height() > height() )
+		return imageSize.scaled( size(), Qt::KeepAspectRatio );
+	else
+		return imageSize;
+}
+
+void
+Frame::invalidate()
+{
+	d->m_dirty = true;
+
+	update();
+}
+
+QRect
+Frame::thumbnailRect() const
+{
+	// Current frame is rendered asynchronously, until then the previous image
+	// is stretched to the place of the new one.
+	const auto size = ( d->m_mode == ResizeMode::FitToSize && !d->m_image.m_isEmpty ?
+		fitSize() : d->m_thumbnail.size() );
+	const int x = ( width() - size.width() ) / 2;
+	const int y = ( height() - size.height() ) / 2;
+
+	return QRect( QPoint( x, y ), size );
 }
 
 QRect
 Frame::imageRect() const
 {
 	if( !d->m_image.m_isEmpty )
-	{
-		const auto img = d->m_image.m_gif.at( d->m_image.m_pos );
-
-		return QRect( 0, 0, img.width(), img.height() );
-	}
+		return QRect( QPoint( 0, 0 ), d->m_image.m_doc.imageSize() );
 	else
 		return {};
 }
@@ -262,9 +415,19 @@ void
 Frame::paintEvent( QPaintEvent * )
 {
 	if( d->m_dirty )
+	{
+		Metrics::add( Metrics::instance().m_thumbnailMisses );
+
 		d->resized();
+	}
+	else
+		Metrics::add( Metrics::instance().m_thumbnailHits );
 
 	QPainter p( this );
+
+	if( d->m_quality == Quality::Preview )
+		p.setRenderHint( QPainter::SmoothPixmapTransform );
+
 	p.drawImage( thumbnailRect(), d->m_thumbnail, d->m_thumbnail.rect() );
 }
 
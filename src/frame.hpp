@@ -27,8 +27,8 @@
 #include <QWidget>
 #include <QScopedPointer>
 
-// qgiflib include.
-#include <qgiflib.hpp>
+// GIF editor include.
+#include "core/document.hpp"
 
 
 //
@@ -37,7 +37,7 @@
 
 //! Reference to full image.
 struct ImageRef final {
-	const QGifLib::Gif & m_gif;
+	const Document & m_doc;
 	qsizetype m_pos;
 	bool m_isEmpty;
 }; // struct ImageRef
@@ -70,6 +70,19 @@ public:
 		FitToHeight
 	}; // enum class ResizeMode
 
+	//! Quality of shown image.
+	enum class Quality {
+		//! Nothing is shown.
+		None,
+		//! Cheap preview scaled to the place of the image.
+		Preview,
+		//! Image rendered to the size of the widget.
+		Full
+	}; // enum class Quality
+
+	//! Delay of stable position in milliseconds before preview is refined.
+	static const int c_refineDelay = 150;
+
 	Frame( const ImageRef & img, ResizeMode mode, QWidget * parent = nullptr, int height = -1 );
 	~Frame() noexcept override;
 
@@ -77,10 +90,25 @@ public:
 	const ImageRef & image() const;
 	//! Set image.
 	void setImagePos( qsizetype pos );
+	//! Image moved to \a pos in document, thumbnail stays actual.
+	void moveImage( qsizetype pos );
 	//! Clear image.
 	void clearImage();
 	//! Apply image.
 	void applyImage();
+	//! Set image at \a pos with already rendered \a thumbnail of it.
+	void setImage( qsizetype pos, const QImage & thumbnail );
+	//! Show \a preview of image at \a pos at once, full quality image is rendered
+	//! when position stays the same for c_refineDelay milliseconds.
+	void setPreview( qsizetype pos, const QImage & preview );
+	//! \return Quality of shown image.
+	Quality quality() const;
+	//! \return Actual thumbnail, null if it's not rendered yet.
+	QImage thumbnail() const;
+	//! \return Size of thumbnail for the current size of widget.
+	QSize fitSize() const;
+	//! Image was edited, thumbnail should be recreated.
+	void invalidate();
 	//! \return Thumbnail image rect.
 	QRect thumbnailRect() const;
 	//! \return Image rect.
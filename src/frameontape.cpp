@@ -31,6 +31,11 @@
 #include <QMenu>
 #include <QContextMenuEvent>
 #include <QFileDialog>
+#include <QSignalBlocker>
+#include <QMouseEvent>
+#include <QApplication>
+#include <QMimeData>
+#include <QDrag>
 
 
 //
@@ -71,6 +76,8 @@ public:
 	QVBoxLayout * m_vlayout;
 	//! Frame.
 	Frame * m_frame;
+	//! Position of mouse press.
+	QPoint m_pressPos;
 	//! Parent.
 	FrameOnTape * q;
 }; // class FrameOnTapePrivate
@@ -142,6 +149,12 @@ FrameOnTape::setImagePos( qsizetype pos )
 	d->m_frame->setImagePos( pos );
 }
 
+void
+FrameOnTape::moveImage( qsizetype pos )
+{
+	d->m_frame->moveImage( pos );
+}
+
 void
 FrameOnTape::clearImage()
 {
@@ -154,6 +167,18 @@ FrameOnTape::applyImage()
 	d->m_frame->applyImage();
 }
 
+void
+FrameOnTape::invalidate()
+{
+	d->m_frame->invalidate();
+}
+
+QImage
+FrameOnTape::thumbnail() const
+{
+	return d->m_frame->thumbnail();
+}
+
 bool
 FrameOnTape::isChecked() const
 {
@@ -163,6 +188,9 @@ FrameOnTape::isChecked() const
 void
 FrameOnTape::setChecked( bool on )
 {
+	// State comes from the model, it's not a change by user.
+	const QSignalBlocker blocker( d->m_checkBox );
+
 	d->m_checkBox->setChecked( on );
 }
 
@@ -192,6 +220,51 @@ FrameOnTape::setCurrent( bool on )
 	d->setCurrent( on );
 }
 
+QString
+FrameOnTape::mimeType()
+{
+	return QStringLiteral( "application/x-gif-editor-frame" );
+}
+
+void
+FrameOnTape::mousePressEvent( QMouseEvent * e )
+{
+	if( e->button() == Qt::LeftButton )
+		d->m_pressPos = e->position().toPoint();
+
+	// Click is handled by frame on release, so press goes on.
+	e->ignore();
+}
+
+void
+FrameOnTape::mouseMoveEvent( QMouseEvent * e )
+{
+	if( !( e->buttons() & Qt::LeftButton ) ||
+		( e->position().toPoint() - d->m_pressPos ).manhattanLength() <
+			QApplication::startDragDistance() )
+	{
+		e->ignore();
+
+		return;
+	}
+
+	auto * data = new QMimeData;
+	data->setData( mimeType(), QByteArray::number( d->m_counter ) );
+
+	auto * drag = new QDrag( this );
+	drag->setMimeData( data );
+
+	const auto thumbnail = d->m_frame->thumbnail();
+
+	if( !thumbnail.isNull() )
+		drag->setPixmap( QPixmap::fromImage( thumbnail.scaledToHeight(
+			qMin( thumbnail.height(), 64 ) ) ) );
+
+	drag->exec( Qt::MoveAction );
+
+	e->accept();
+}
+
 void
 FrameOnTape::contextMenuEvent( QContextMenuEvent * e )
 {
@@ -211,9 +284,8 @@ FrameOnTape::contextMenuEvent( QContextMenuEvent * e )
 					if( !fileName.endsWith( QStringLiteral( ".png" ), Qt::CaseInsensitive ) )
 						fileName.append( QStringLiteral( ".png" ) );
 
-					const auto img = this->d->m_frame->image().m_gif.at(
-						this->d->m_frame->image().m_pos );
-					img.save( fileName );
+					const auto & ref = this->d->m_frame->image();
+					ref.m_doc.image( ref.m_pos ).save( fileName );
 				}
 			} );
 
@@ -59,14 +59,20 @@ public:
 	const ImageRef & image() const;
 	//! Set image.
 	void setImagePos( qsizetype pos );
+	//! Image moved to \a pos in document, thumbnail stays actual.
+	void moveImage( qsizetype pos );
 	//! Clear image.
 	void clearImage();
 	//! Apply image.
 	void applyImage();
+	//! Image was edited, thumbnail should be recreated.
+	void invalidate();
+	//! \return Actual thumbnail, null if it's not rendered yet.
+	QImage thumbnail() const;
 
 	//! \return Is frame checked.
 	bool isChecked() const;
-	//! Set checked.
+	//! Set checked, checked() is not emitted.
 	void setChecked( bool on = true );
 
 	//! \return Counter.
@@ -79,8 +85,13 @@ public:
 	//! Set current flag.
 	void setCurrent( bool on = true );
 
+	//! \return MIME type of dragged frame, data is its counter.
+	static QString mimeType();
+
 protected:
 	void contextMenuEvent( QContextMenuEvent * e ) override;
+	void mousePressEvent( QMouseEvent * e ) override;
+	void mouseMoveEvent( QMouseEvent * e ) override;
 
 private:
 	Q_DISABLE_COPY( FrameOnTape )
@@ -21,17 +21,59 @@
 */
 
 // Qt include.
-#include <QApplication>
 #include <QTranslator>
 #include <QLocale>
+#include <QSettings>
 
 // GIF editor include.
+#include "application.hpp"
 #include "mainwindow.hpp"
+#include "cli.hpp"
+#include "core/trace.hpp"
+#include "core/scheduler.hpp"
+#include "core/watchdog.hpp"
+#include "core/tempfiles.hpp"
+
+// C++ include.
+#include <cstdlib>
+
+
+//! Time to wait for running tasks on quit in milliseconds.
+static const qint64 c_quitTimeout = 100;
 
 
 int main( int argc, char ** argv )
 {
-	QApplication app( argc, argv );
+	const TraceSession trace( argc, argv );
+
+	if( isHeadless( argc, argv ) )
+		return runHeadless( argc, argv );
+
+	Application app( argc, argv );
+
+	// Count of worker threads: "--threads <count>" or "threads" in settings, 0 - count of cores.
+	QSettings settings( QStringLiteral( "gif-editor" ), QStringLiteral( "gif-editor" ) );
+	int threads = settings.value( QStringLiteral( "threads" ), 0 ).toInt();
+	// Threshold of UI stalls in milliseconds: "--stall-threshold <ms>" or "stallThreshold", 0 - off.
+	qint64 stallThreshold = settings.value( QStringLiteral( "stallThreshold" ),
+		Watchdog::c_defaultThreshold ).toLongLong();
+
+	const auto args = QCoreApplication::arguments();
+
+	for( qsizetype i = 1; i < args.size(); ++i )
+	{
+		if( args.at( i ) == QStringLiteral( "--threads" ) && i + 1 < args.size() )
+			threads = args.at( i + 1 ).toInt();
+		else if( args.at( i ).startsWith( QStringLiteral( "--threads=" ) ) )
+			threads = args.at( i ).mid( 10 ).toInt();
+		else if( args.at( i ) == QStringLiteral( "--stall-threshold" ) && i + 1 < args.size() )
+			stallThreshold = args.at( i + 1 ).toLongLong();
+		else if( args.at( i ).startsWith( QStringLiteral( "--stall-threshold=" ) ) )
+			stallThreshold = args.at( i ).mid( 18 ).toLongLong();
+	}
+
+	Scheduler::setDefaultThreadCount( qMax( 0, threads ) );
+	app.setStallThreshold( stallThreshold );
 
 	QIcon appIcon( QStringLiteral( ":/img/icon_256x256.png" ) );
 	appIcon.addFile( QStringLiteral( ":/img/icon_128x128.png" ) );
@@ -46,9 +88,28 @@ int main( int argc, char ** argv )
 	if( appTranslator.load( QStringLiteral( "./tr/gif-editor_" ) + QLocale::system().name() ) )
 		app.installTranslator( &appTranslator );
 
-	MainWindow w;
-	w.resize( 800, 600 );
-	w.show();
+	int code = 0;
+
+	{
+		MainWindow w;
+		w.resize( 800, 600 );
+		w.show();
+
+		code = app.exec();
+	}
+
+	// Encoding in qgiflib can't be interrupted, cancelled jobs that still run hold
+	// copies of what they need and their results are dropped, so quit doesn't wait
+	// for them. Workers would be joined at exit, so the process exits at once,
+	// temporary files of these jobs are removed first.
+	if( !Scheduler::instance().waitForDone( c_quitTimeout ) )
+	{
+		TemporaryFiles::removeAll();
+
+		Trace::stop();
+
+		std::_Exit( code );
+	}
 
-	return app.exec();
+	return code;
 }
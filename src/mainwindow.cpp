@@ -28,9 +28,21 @@
 #include "frameontape.hpp"
 #include "busyindicator.hpp"
 #include "about.hpp"
+#include "metricsdock.hpp"
+#include "core/document.hpp"
+#include "core/history.hpp"
+#include "core/exporter.hpp"
+#include "core/trace.hpp"
+#include "core/metrics.hpp"
+#include "core/job.hpp"
+#include "core/progress.hpp"
+#include "core/playback.hpp"
+#include "core/framemodel.hpp"
+#include "core/similarity.hpp"
 
 // Qt include.
 #include <QMenuBar>
+#include <QMenu>
 #include <QApplication>
 #include <QMessageBox>
 #include <QCloseEvent>
@@ -42,90 +54,28 @@
 #include <QToolBar>
 #include <QVector>
 #include <QStackedWidget>
-#include <QRunnable>
-#include <QThreadPool>
 #include <QStandardPaths>
 #include <QResizeEvent>
 #include <QTimer>
 #include <QMetaMethod>
+#include <QUndoStack>
+#include <QElapsedTimer>
+#include <QStatusBar>
+#include <QInputDialog>
+#include <QLineEdit>
+#include <QDir>
 
 // C++ include.
 #include <vector>
 #include <algorithm>
 #include <utility>
+#include <memory>
+#include <functional>
 
 // Widgets include.
 #include <Widgets/LicenseDialog>
 
 
-namespace /* anonymous */ {
-
-class ReadGIF final
-	:	public QRunnable
-{
-public:
-	ReadGIF( QGifLib::Gif * container,
-		const QString & fileName )
-		:	m_container( container )
-		,	m_fileName( fileName )
-	{
-		setAutoDelete( false );
-	}
-
-	void run() override
-	{
-		m_container->load( m_fileName );
-	}
-
-private:
-	QGifLib::Gif * m_container;
-	QString m_fileName;
-}; // class ReadGIF
-
-
-class CropGIF final
-	:	public QRunnable
-{
-public:
-	CropGIF( BusyIndicator * receiver,
-		QGifLib::Gif * container,
-		const QRect & rect )
-		:	m_container( container )
-		,	m_rect( rect )
-		,	m_receiver( receiver )
-	{
-		setAutoDelete( false );
-	}
-
-	void run() override
-	{	
-		const auto index = m_receiver->metaObject()->indexOfProperty( "percent" );
-		auto property = m_receiver->metaObject()->property( index );
-		
-		int current = 0;
-		const auto count = m_container->fileNames().size();
-		
-		property.write( m_receiver, 0 );
-		
-		for( const auto & fileName : m_container->fileNames() )
-		{
-			QImage( fileName ).copy( m_rect ).save( fileName );
-			++current;
-			property.write( m_receiver, qRound( ( (double) current / (double) count ) * 100.0 ) );
-		}
-		
-		property.write( m_receiver, 100 );
-	}
-
-private:
-	QGifLib::Gif * m_container;
-	QRect m_rect;
-	BusyIndicator * m_receiver;
-}; // class CropGIF
-
-} /* namespace anonymous */
-
-
 //
 // MainWindowPrivate
 //
@@ -137,24 +87,38 @@ public:
 		,	m_busyFlag( false )
 		,	m_quitFlag( false )
 		,	m_playing( false )
+		,	m_changed( false )
 		,	m_stack( new QStackedWidget( parent ) )
 		,	m_busy( new BusyIndicator( m_stack ) )
-		,	m_view( new View( m_frames, m_stack ) )
+		,	m_view( new View( m_doc, m_stack ) )
 		,	m_about( new About( parent ) )
+		,	m_undoStack( new QUndoStack( parent ) )
+		,	m_job( new Job( parent ) )
+		,	m_progress( std::make_shared< Progress > () )
+		,	m_progressTimer( new QTimer( parent ) )
+		,	m_model( new FrameModel( parent ) )
 		,	m_crop( nullptr )
 		,	m_playStop( nullptr )
 		,	m_save( nullptr )
 		,	m_saveAs( nullptr )
+		,	m_append( nullptr )
+		,	m_splitMenu( nullptr )
 		,	m_open( nullptr )
 		,	m_applyEdit( nullptr )
 		,	m_cancelEdit( nullptr )
 		,	m_quit( nullptr )
+		,	m_cancelJob( nullptr )
 		,	m_editToolBar( nullptr )
+		,	m_metrics( nullptr )
+		,	m_selectMenu( nullptr )
 		,	q( parent )
 	{
 		m_busy->setRadius( 75 );
 	}
 
+	//! Time of one batch of frames added to tape in milliseconds.
+	static const int c_tapeBatch = 16;
+
 	//! Edit mode.
 	enum class EditMode {
 		Unknow,
@@ -168,6 +132,8 @@ public:
 	{
 		m_save->setEnabled( on );
 		m_saveAs->setEnabled( on );
+		m_append->setEnabled( on );
+		m_splitMenu->setEnabled( on );
 		m_open->setEnabled( on );
 
 		m_applyEdit->setEnabled( !on );
@@ -175,16 +141,14 @@ public:
 
 		m_playStop->setEnabled( on );
 	}
-	//! Initialize tape.
-	void initTape()
-	{
-		for( qsizetype i = 0, last = m_frames.count(); i < last; ++i )
-		{
-			m_view->tape()->addFrame( { m_frames, i, false } );
-
-			QApplication::processEvents();
-		};
-	}
+	/*!
+		Add frames of document starting at \a first to tape, \a done is called
+		after the last frame. Frames are added in batches between passes
+		of event loop, so events are not processed inside of a batch.
+	*/
+	void initTape( qsizetype first, const std::function< void () > & done );
+	//! Add batch of frames to tape starting at \a pos.
+	void addTapeFrames( qsizetype pos, const std::function< void () > & done );
 	//! Busy state.
 	void busy()
 	{
@@ -194,11 +158,22 @@ public:
 
 		m_busy->setRunning( true );
 
+		showProgress();
+		m_progressTimer->start();
+
 		m_crop->setEnabled( false );
 		m_save->setEnabled( false );
 		m_saveAs->setEnabled( false );
+		m_append->setEnabled( false );
+		m_splitMenu->setEnabled( false );
 		m_open->setEnabled( false );
 		m_quit->setEnabled( false );
+		m_cancelJob->setEnabled( true );
+		m_selectMenu->setEnabled( false );
+
+		// Escape is shared with cancel of edit, only one of them may be enabled.
+		m_applyEdit->setEnabled( false );
+		m_cancelEdit->setEnabled( false );
 
 		m_editToolBar->hide();
 	}
@@ -211,87 +186,87 @@ public:
 
 		m_busy->setRunning( false );
 
+		m_progressTimer->stop();
+		m_busy->setShowPercent( false );
+		m_busy->setDetails( QString() );
+
 		m_crop->setEnabled( true );
 
-		if( !m_currentGif.isEmpty() )
+		if( !m_doc.fileName().isEmpty() )
 		{
 			if( q->isWindowModified() )
 				m_save->setEnabled( true );
 
 			m_saveAs->setEnabled( true );
+			m_append->setEnabled( true );
+			m_splitMenu->setEnabled( true );
 		}
 
 		m_open->setEnabled( true );
 		m_quit->setEnabled( true );
+		m_cancelJob->setEnabled( false );
+		m_selectMenu->setEnabled( true );
+
+		const bool editing = ( m_editMode != EditMode::Unknow );
+
+		m_applyEdit->setEnabled( editing );
+		m_cancelEdit->setEnabled( editing );
 
 		m_editToolBar->show();
 	}
-	//! Wait for thread pool.
-	void waitThreadPool()
-	{
-		while( !QThreadPool::globalInstance()->waitForDone( 5 ) )
-			QApplication::processEvents();
-	}
-	//! Set modified state.
+	//! Set modified state of changes outside of undo history, not modified state is clean.
 	void setModified( bool on )
 	{
-		q->setWindowModified( on );
-
-		if( on )
-			m_save->setEnabled( true );
-		else
-			m_save->setEnabled( false );
-	}
-
-	//! \return Index of the next checked frame.
-	int nextCheckedFrame( int current ) const
-	{
-		for( int i = current + 1; i <= m_view->tape()->count(); ++i )
-		{
-			if( m_view->tape()->frame( i )->isChecked() )
-				return i;
-		}
+		m_changed = on;
 
-		for( int i = 1; i < current; ++i )
-		{
-			if( m_view->tape()->frame( i )->isChecked() )
-				return i;
-		}
+		if( !on )
+			m_undoStack->setClean();
 
-		return -1;
+		updateModified();
 	}
-
-	void openGif( const QString & fileName )
+	//! Show modified state, edits are modified until undo history returns to clean state.
+	void updateModified()
 	{
-		clearView();
+		const bool on = ( m_changed || !m_undoStack->isClean() );
 
-		setModified( false );
-
-		m_currentGif = fileName;
-
-		ReadGIF read( &m_frames, fileName );
-		QThreadPool::globalInstance()->start( &read );
-
-		waitThreadPool();
-
-		QFileInfo info( fileName );
-
-		q->setWindowTitle( MainWindow::tr( "GIF Editor - %1[*]" ).arg( info.fileName() ) );
-
-		initTape();
-
-		if( m_frames.count() )
-			m_view->tape()->setCurrentFrame( 1 );
+		q->setWindowModified( on );
 
-		m_crop->setEnabled( true );
-		m_playStop->setEnabled( true );
-		m_saveAs->setEnabled( true );
+		m_save->setEnabled( on );
 	}
 
-	//! Current file name.
-	QString m_currentGif;
-	//! Frames.
-	QGifLib::Gif m_frames;
+	//! Start playback of checked frames from the current one.
+	void startPlayback();
+	//! Stop playback.
+	void stopPlayback();
+	//! Show statistics of playback in status bar.
+	void showPlaybackStats();
+	//! Make frame with the given counter current.
+	void goToFrame( int counter );
+	//! Delete unchecked frames from document.
+	void deleteUnchecked();
+	//! Move \a count frames starting at counter \a first, so they start at counter \a to.
+	void moveFrames( int first, int count, int to );
+	//! Replace frames with frames at positions \a order, positions may repeat.
+	void rearrange( const QVector< qsizetype > & order );
+	//! Uncheck frames that differ from the previous one less than \a percent of pixels.
+	void uncheckSimilar( double percent );
+	//! Show sample of progress on busy indicator.
+	void showProgress();
+	//! Open GIF, \a done is called after successful load.
+	void openGif( const QString & fileName, const std::function< void () > & done = {} );
+	//! Append GIFs to the end of the document.
+	void appendGifs( const QStringList & fileNames );
+	/*!
+		Split checked frames into GIFs, segments start at frames \a cuts and,
+		if \a percent isn't negative, at frames that differ from the previous
+		one in not less than \a percent of pixels.
+	*/
+	void split( const QVector< int > & cuts, double percent = -1.0 );
+	//! Save GIF, \a done is called after successful save, otherwise saved GIF is reopened.
+	void save( const std::function< void () > & done = {} );
+
+	//! Document.
+	Document m_doc;
 	//! Edit mode.
 	EditMode m_editMode;
 	//! Busy flag.
@@ -300,6 +275,8 @@ public:
 	bool m_quitFlag;
 	//! Play/stop flag.
 	bool m_playing;
+	//! Frames changed outside of undo history.
+	bool m_changed;
 	//! Stacked widget.
 	QStackedWidget * m_stack;
 	//! Busy indicator.
@@ -308,6 +285,16 @@ public:
 	View * m_view;
 	//! Widget about.
 	About * m_about;
+	//! Undo/redo history of edits.
+	QUndoStack * m_undoStack;
+	//! Load or save job.
+	Job * m_job;
+	//! Progress of the job, new for every job as cancelled job may still run.
+	std::shared_ptr< Progress > m_progress;
+	//! Timer sampling progress.
+	QTimer * m_progressTimer;
+	//! Checked state and delays of frames.
+	FrameModel * m_model;
 	//! Crop action.
 	QAction * m_crop;
 	//! Play/stop action.
@@ -316,6 +303,10 @@ public:
 	QAction * m_save;
 	//! Save as action.
 	QAction * m_saveAs;
+	//! Append action.
+	QAction * m_append;
+	//! Menu of split.
+	QMenu * m_splitMenu;
 	//! Open action.
 	QAction * m_open;
 	//! Apply edit action.
@@ -324,20 +315,714 @@ public:
 	QAction * m_cancelEdit;
 	//! Quit action.
 	QAction * m_quit;
+	//! Cancel job action.
+	QAction * m_cancelJob;
 	//! Edit toolbar.
 	QToolBar * m_editToolBar;
 	//! Play timer.
 	QTimer * m_playTimer;
+	//! Clock of playback.
+	PlaybackClock m_playback;
+	//! Renderer of frames for playback.
+	PlaybackRenderer m_renderer;
+	//! Frames on tape in order of playback.
+	QVector< int > m_playFrames;
+	//! Performance dock.
+	MetricsDock * m_metrics;
+	//! Menu of selection.
+	QMenu * m_selectMenu;
 	//! Parent.
 	MainWindow * q;
 }; // class MainWindowPrivate
 
+const int MainWindowPrivate::c_tapeBatch;
+
+void
+MainWindowPrivate::openGif( const QString & fileName, const std::function< void () > & done )
+{
+	if( m_playing )
+		stopPlayback();
+
+	m_progress = std::make_shared< Progress > ();
+
+	busy();
+
+	// Loaded into a separate document, so cancelled or failed load doesn't touch the current one.
+	auto doc = std::make_shared< Document > ();
+	auto progress = m_progress;
+
+	m_job->start(
+		[doc, fileName, progress] ( const JobControl & job )
+		{
+			// qgiflib doesn't report progress of decoding, only time is shown.
+			progress->begin( Progress::Stage::Decoding );
+
+			return doc->load( fileName, job.token() );
+		},
+		[this, doc, fileName, done] ( Job::Result result )
+		{
+			if( m_quitFlag )
+			{
+				QApplication::quit();
+
+				return;
+			}
+
+			switch( result )
+			{
+				case Job::Result::Succeeded :
+					break;
+
+				case Job::Result::Failed :
+				{
+					ready();
+
+					QMessageBox::critical( q, MainWindow::tr( "Failed to open GIF..." ),
+						MainWindow::tr( "Unable to read \"%1\"." ).arg( fileName ) );
+				}
+					return;
+
+				case Job::Result::Cancelled :
+					ready();
+					return;
+			}
+
+			clearView();
+
+			setModified( false );
+
+			m_doc.swap( *doc );
+			m_doc.setFileName( fileName );
+
+			QFileInfo info( fileName );
+
+			q->setWindowTitle( MainWindow::tr( "GIF Editor - %1[*]" ).arg( info.fileName() ) );
+
+			QVector< int > delays;
+			delays.reserve( m_doc.count() );
+
+			for( qsizetype i = 0; i < m_doc.count(); ++i )
+				delays.push_back( m_doc.frames().delay( i ) );
+
+			m_model->reset( delays );
+
+			initTape( 0,
+				[this, done] ()
+				{
+					if( m_doc.count() )
+						m_view->tape()->setCurrentFrame( 1 );
+
+					ready();
+
+					m_crop->setEnabled( true );
+					m_playStop->setEnabled( true );
+					m_saveAs->setEnabled( true );
+					m_append->setEnabled( true );
+					m_splitMenu->setEnabled( true );
+
+					if( done )
+						done();
+				} );
+		},
+		Scheduler::Priority::Interactive );
+}
+
+void
+MainWindowPrivate::initTape( qsizetype first, const std::function< void () > & done )
+{
+	m_progress->begin( Progress::Stage::Building, m_doc.count() - first );
+
+	addTapeFrames( first, done );
+}
+
+void
+MainWindowPrivate::addTapeFrames( qsizetype pos, const std::function< void () > & done )
+{
+	if( m_quitFlag )
+	{
+		QApplication::quit();
+
+		return;
+	}
+
+	{
+		TRACE_SPAN( "initTape" );
+
+		QElapsedTimer timer;
+		timer.start();
+
+		// Batch takes about one frame of display, busy indicator is repainted between batches.
+		for( const auto last = m_doc.count(); pos < last && !timer.hasExpired( c_tapeBatch ); ++pos )
+		{
+			m_view->tape()->addFrame( { m_doc, pos, false } );
+
+			m_progress->add();
+		}
+	}
+
+	if( pos < m_doc.count() )
+		QTimer::singleShot( 0, q, [this, pos, done] () { addTapeFrames( pos, done ); } );
+	else if( done )
+		done();
+}
+
+void
+MainWindowPrivate::appendGifs( const QStringList & fileNames )
+{
+	if( m_busyFlag || m_doc.fileName().isEmpty() )
+		return;
+
+	if( m_playing )
+		stopPlayback();
+
+	m_progress = std::make_shared< Progress > ();
+
+	busy();
+
+	// GIFs are decoded one by one into a separate store, decoded frames are kept
+	// in files of qgiflib and only cached ones are in memory.
+	auto frames = std::make_shared< FrameStore > ();
+	auto progress = m_progress;
+
+	m_job->start(
+		[frames, fileNames, progress] ( const JobControl & job )
+		{
+			progress->begin( Progress::Stage::Decoding, fileNames.size() );
+
+			for( const auto & fileName : fileNames )
+			{
+				FrameStore gif;
+
+				if( !gif.load( fileName, job.token() ) )
+					return false;
+
+				frames->append( gif );
+
+				progress->add();
+			}
+
+			return true;
+		},
+		[this, frames, fileNames] ( Job::Result result )
+		{
+			if( m_quitFlag )
+			{
+				QApplication::quit();
+
+				return;
+			}
+
+			if( result != Job::Result::Succeeded )
+			{
+				ready();
+
+				if( result == Job::Result::Failed )
+					QMessageBox::critical( q, MainWindow::tr( "Failed to append GIFs..." ),
+						MainWindow::tr( "Unable to read some of GIFs:\n%1" )
+							.arg( fileNames.join( QLatin1Char( '\n' ) ) ) );
+
+				return;
+			}
+
+			const auto first = m_doc.count();
+
+			m_doc.frames().append( *frames );
+
+			QVector< int > delays;
+			delays.reserve( m_doc.count() - first );
+
+			for( auto i = first; i < m_doc.count(); ++i )
+				delays.push_back( m_doc.frames().delay( i ) );
+
+			m_model->append( delays );
+
+			initTape( first,
+				[this] ()
+				{
+					m_view->tape()->update();
+
+					ready();
+
+					setModified( true );
+				} );
+		},
+		Scheduler::Priority::Interactive );
+}
+
+void
+MainWindowPrivate::startPlayback()
+{
+	m_playTimer->stop();
+	m_playFrames.clear();
+
+	const auto positions = m_model->checkedIndices();
+	QVector< int > delays;
+	delays.reserve( positions.size() );
+	m_playFrames.reserve( positions.size() );
+
+	for( const auto & pos : positions )
+	{
+		m_playFrames.push_back( static_cast< int > ( pos ) + 1 );
+		delays.push_back( m_model->delay( static_cast< int > ( pos ) ) );
+	}
+
+	// Checked frames before the current one are played at the end of the loop.
+	const auto * current = m_view->tape()->currentFrame();
+	int first = ( current ? m_model->rank( current->counter() - 1 ) : 0 );
+
+	if( first >= positions.size() )
+		first = 0;
+
+	m_playback.start( delays, first );
+
+	if( m_playback.isRunning() )
+	{
+		m_renderer.start( m_doc, positions, m_view->currentFrame()->fitSize(), first );
+		m_playTimer->start( 0 );
+	}
+	else
+		m_renderer.stop();
+}
+
+void
+MainWindowPrivate::stopPlayback()
+{
+	m_playTimer->stop();
+	m_playback.stop();
+	m_renderer.stop();
+	showPlaybackStats();
+	m_playStop->setText( MainWindow::tr( "Play" ) );
+	m_playStop->setIcon( QIcon( ":/img/media-playback-start.png" ) );
+	m_playing = false;
+}
+
+void
+MainWindowPrivate::showPlaybackStats()
+{
+	q->statusBar()->showMessage( MainWindow::tr( "Playback: %1 of %2 fps, dropped %3 of %4 frames" )
+		.arg( m_playback.achievedFps(), 0, 'f', 1 )
+		.arg( m_playback.targetFps(), 0, 'f', 1 )
+		.arg( m_playback.droppedFrames() )
+		.arg( m_playback.droppedFrames() + m_playback.shownFrames() ) );
+}
+
+void
+MainWindowPrivate::goToFrame( int counter )
+{
+	auto * tape = m_view->tape();
+
+	if( m_busyFlag || m_playing || !tape->count() )
+		return;
+
+	counter = qBound( 1, counter, tape->count() );
+
+	// Auto-repeated keys produce requests faster than frames are rendered, the view
+	// renders only the latest of them.
+	if( !tape->currentFrame() || tape->currentFrame()->counter() != counter )
+	{
+		tape->setCurrentFrame( counter );
+		m_view->scrollTo( counter );
+	}
+}
+
+void
+MainWindowPrivate::deleteUnchecked()
+{
+	if( m_busyFlag || !m_model->checkedCount() || m_model->checkedCount() == m_model->count() )
+		return;
+
+	if( m_playing )
+		stopPlayback();
+
+	// Store, model and tape are compacted in place, decoded frames and thumbnails
+	// of the rest are kept.
+	m_doc.frames().keep( m_model->checkedIndices() );
+	m_model->removeUnchecked();
+	m_view->tape()->removeUnchecked();
+
+	setModified( true );
+}
+
+void
+MainWindowPrivate::moveFrames( int first, int count, int to )
+{
+	const int c = m_view->tape()->count();
+
+	if( m_busyFlag || count <= 0 || first < 1 || first + count - 1 > c ||
+		to < 1 || to > c - count + 1 || to == first )
+			return;
+
+	const bool playing = m_playing;
+
+	if( playing )
+		stopPlayback();
+
+	// Only handles, flags and widgets are reordered, no frame is decoded or rendered.
+	m_doc.frames().move( first - 1, count, to - 1 );
+	m_model->move( first - 1, count, to - 1 );
+	m_view->tape()->moveFrames( first, count, to );
+	m_view->scrollTo( to );
+
+	setModified( true );
+
+	if( playing )
+		startPlayback();
+}
+
+void
+MainWindowPrivate::rearrange( const QVector< qsizetype > & order )
+{
+	if( m_busyFlag || !m_doc.count() )
+		return;
+
+	const bool playing = m_playing;
+
+	if( playing )
+		stopPlayback();
+
+	// Handles are shared, so repeated frames refer to the same decoded images.
+	m_doc.frames().rearrange( order );
+	m_model->rearrange( order );
+	m_view->tape()->rearrange( order );
+
+	setModified( true );
+
+	if( playing )
+		startPlayback();
+}
+
+void
+MainWindowPrivate::uncheckSimilar( double percent )
+{
+	if( !m_model->count() )
+		return;
+
+	m_progress = std::make_shared< Progress > ();
+
+	busy();
+
+	// Job gets a reader and copies of handles, so document may change while frames are compared.
+	const auto frames = m_doc.frames().reader();
+	QVector< FrameHandle > handles;
+	handles.reserve( m_doc.count() );
+
+	for( qsizetype i = 0; i < m_doc.count(); ++i )
+		handles.push_back( m_doc.frames().handle( i ) );
+
+	const auto edits = m_doc.edits();
+	auto progress = m_progress;
+	auto diffs = std::make_shared< QVector< double > > ();
+
+	m_job->start(
+		[frames, handles, edits, progress, diffs] ( const JobControl & job )
+		{
+			*diffs = frameDifferences( frames, handles, edits, job.token(), progress.get() );
+
+			return !diffs->isEmpty();
+		},
+		[this, diffs, percent] ( Job::Result result )
+		{
+			if( m_quitFlag )
+			{
+				QApplication::quit();
+
+				return;
+			}
+
+			ready();
+
+			if( result == Job::Result::Succeeded && diffs->size() == m_model->count() )
+			{
+				const auto threshold = percent / 100.0;
+
+				m_model->setCheckedIf( [this, diffs, threshold] ( int idx )
+					{ return m_model->isChecked( idx ) && diffs->at( idx ) >= threshold; } );
+			}
+		},
+		Scheduler::Priority::Interactive );
+}
+
+void
+MainWindowPrivate::showProgress()
+{
+	const auto s = m_progress->sample();
+
+	QString stage;
+
+	switch( s.m_stage )
+	{
+		case Progress::Stage::Decoding :
+			stage = MainWindow::tr( "Decoding GIF" );
+			break;
+
+		case Progress::Stage::Building :
+			stage = MainWindow::tr( "Creating frames" );
+			break;
+
+		case Progress::Stage::Rendering :
+			stage = MainWindow::tr( "Applying edits" );
+			break;
+
+		case Progress::Stage::Encoding :
+			stage = MainWindow::tr( "Encoding GIF" );
+			break;
+
+		case Progress::Stage::Comparing :
+			stage = MainWindow::tr( "Comparing frames" );
+			break;
+
+		default :
+			break;
+	}
+
+	const auto percent = s.percent();
+
+	m_busy->setShowPercent( percent >= 0 );
+	m_busy->setPercent( qMax( 0, percent ) );
+
+	if( stage.isEmpty() )
+		m_busy->setDetails( QString() );
+	else if( s.m_total > 0 )
+	{
+		const auto eta = s.eta();
+
+		m_busy->setDetails( MainWindow::tr( "%1: %2 of %3 frames\n%4 frames/s, %5 left" )
+			.arg( stage )
+			.arg( s.m_done )
+			.arg( s.m_total )
+			.arg( s.framesPerSecond(), 0, 'f', 1 )
+			.arg( eta >= 0 ? QStringLiteral( "%1:%2" ).arg( eta / 60000 )
+					.arg( ( eta / 1000 ) % 60, 2, 10, QLatin1Char( '0' ) ) :
+				QStringLiteral( "-" ) ) );
+	}
+	else
+		m_busy->setDetails( MainWindow::tr( "%1: %2 s" ).arg( stage ).arg( s.m_msecs / 1000 ) );
+}
+
+void
+MainWindowPrivate::split( const QVector< int > & cuts, double percent )
+{
+	if( !m_model->checkedCount() )
+	{
+		QMessageBox::information( q, MainWindow::tr( "Can't split GIF..." ),
+			MainWindow::tr( "Can't split GIF image with no frames." ) );
+
+		return;
+	}
+
+	const QFileInfo info( m_doc.fileName() );
+
+	const auto dir = QFileDialog::getExistingDirectory( q, MainWindow::tr( "Split GIF..." ),
+		info.absolutePath() );
+
+	if( dir.isEmpty() )
+		return;
+
+	if( m_playing )
+		stopPlayback();
+
+	m_progress = std::make_shared< Progress > ();
+
+	busy();
+
+	// Handles keep decoded GIFs alive and scene cuts are detected through a reader,
+	// so nothing in the job refers to the document.
+	const auto frames = m_doc.frames().reader();
+	QVector< FrameHandle > handles;
+	QVector< bool > checked;
+	handles.reserve( m_doc.count() );
+	checked.reserve( m_doc.count() );
+
+	for( int i = 0; i < m_model->count(); ++i )
+	{
+		handles.push_back( m_doc.frames().handle( i ) );
+		handles.back().m_delay = m_model->delay( i );
+		checked.push_back( m_model->isChecked( i ) );
+	}
+
+	const auto edits = m_doc.edits();
+	const auto baseName = QDir( dir ).filePath( info.completeBaseName() );
+	auto progress = m_progress;
+	auto written = std::make_shared< qsizetype > ( 0 );
+
+	m_job->start(
+		[frames, handles, checked, cuts, percent, edits, baseName, progress, written]
+			( const JobControl & job )
+		{
+			QVector< bool > starts( handles.size(), false );
+
+			for( const auto & cut : cuts )
+			{
+				if( cut >= 0 && cut < starts.size() )
+					starts[ cut ] = true;
+			}
+
+			if( percent >= 0.0 )
+			{
+				const auto diffs = frameDifferences( frames, handles, edits, job.token(),
+					progress.get() );
+
+				if( diffs.size() != handles.size() )
+					return false;
+
+				const auto threshold = percent / 100.0;
+
+				for( qsizetype i = 1; i < diffs.size(); ++i )
+				{
+					if( diffs.at( i ) >= threshold )
+						starts[ i ] = true;
+				}
+			}
+
+			// Unchecked frames are skipped, segment without checked frames isn't written.
+			QVector< Segment > segments;
+			Segment segment;
+
+			for( qsizetype i = 0; i < handles.size(); ++i )
+			{
+				if( starts.at( i ) && !segment.m_frames.isEmpty() )
+				{
+					segments.push_back( std::move( segment ) );
+					segment = Segment();
+				}
+
+				if( checked.at( i ) )
+					segment.m_frames.push_back( handles.at( i ) );
+			}
+
+			if( !segment.m_frames.isEmpty() )
+				segments.push_back( std::move( segment ) );
+
+			for( qsizetype i = 0; i < segments.size(); ++i )
+				segments[ i ].m_fileName = QStringLiteral( "%1-%2.gif" ).arg( baseName )
+					.arg( i + 1, 3, 10, QLatin1Char( '0' ) );
+
+			Exporter exporter;
+			exporter.setProgress( progress.get() );
+
+			*written = segments.size();
+
+			return exporter.write( segments, edits, job.token() );
+		},
+		[this, dir, written] ( Job::Result result )
+		{
+			if( m_quitFlag )
+			{
+				QApplication::quit();
+
+				return;
+			}
+
+			ready();
+
+			switch( result )
+			{
+				case Job::Result::Succeeded :
+					q->statusBar()->showMessage( MainWindow::tr( "Written %1 GIFs to \"%2\"." )
+						.arg( *written ).arg( dir ) );
+					break;
+
+				case Job::Result::Failed :
+					QMessageBox::critical( q, MainWindow::tr( "Failed to split GIF..." ),
+						MainWindow::tr( "Unable to write GIFs to \"%1\"." ).arg( dir ) );
+					break;
+
+				case Job::Result::Cancelled :
+					break;
+			}
+		} );
+}
+
+void
+MainWindowPrivate::save( const std::function< void () > & done )
+{
+	QVector< FrameHandle > toSave;
+	toSave.reserve( m_model->checkedCount() );
+
+	for( const auto & pos : m_model->checkedIndices() )
+	{
+		toSave.push_back( m_doc.frames().handle( pos ) );
+		toSave.back().m_delay = m_model->delay( static_cast< int > ( pos ) );
+	}
+
+	if( toSave.empty() )
+	{
+		QMessageBox::information( q, MainWindow::tr( "Can't save GIF..." ),
+			MainWindow::tr( "Can't save GIF image with no frames." ) );
+
+		return;
+	}
+
+	m_progress = std::make_shared< Progress > ();
+
+	busy();
+
+	const auto fileName = m_doc.fileName();
+	const auto edits = m_doc.edits();
+	auto progress = m_progress;
+
+	m_job->start(
+		[toSave, edits, fileName, progress] ( const JobControl & job )
+		{
+			Exporter exporter;
+			exporter.setProgress( progress.get() );
+
+			return exporter.write( toSave, edits, fileName, job.token() );
+		},
+		[this, fileName, done] ( Job::Result result )
+		{
+			if( m_quitFlag )
+			{
+				QApplication::quit();
+
+				return;
+			}
+
+			switch( result )
+			{
+				case Job::Result::Succeeded :
+				{
+					// Saved document isn't modified even if it fails to reopen.
+					setModified( false );
+
+					if( done )
+					{
+						ready();
+
+						done();
+					}
+					else
+						openGif( fileName );
+				}
+					break;
+
+				case Job::Result::Failed :
+				{
+					ready();
+
+					QMessageBox::critical( q, MainWindow::tr( "Failed to save GIF..." ),
+						MainWindow::tr( "Unable to write \"%1\"." ).arg( fileName ) );
+				}
+					break;
+
+				case Job::Result::Cancelled :
+					ready();
+					break;
+			}
+		} );
+}
+
 void
 MainWindowPrivate::clearView()
 {
+	if( m_playing )
+		stopPlayback();
+
 	m_view->currentFrame()->clearImage();
 	m_view->tape()->clear();
-	m_frames.clean();
+	m_undoStack->clear();
+	m_doc.clear();
+	m_model->clear();
 }
 
 
@@ -359,11 +1044,100 @@ MainWindow::MainWindow()
 	d->m_saveAs = file->addAction( QIcon( QStringLiteral( ":/img/document-save-as.png" ) ), tr( "Save As" ),
 		this, &MainWindow::saveGifAs );
 	file->addSeparator();
+	d->m_append = file->addAction( tr( "Append..." ), this,
+		[this] ()
+		{
+			static const auto pictureLocations =
+				QStandardPaths::standardLocations( QStandardPaths::PicturesLocation );
+
+			const auto fileNames = QFileDialog::getOpenFileNames( this,
+				tr( "Append GIFs..." ),
+				( !pictureLocations.isEmpty() ? pictureLocations.first() : QString() ),
+				tr( "GIF (*.gif)" ) );
+
+			if( !fileNames.isEmpty() )
+				d->appendGifs( fileNames );
+		} );
+	d->m_splitMenu = file->addMenu( tr( "Split" ) );
+	d->m_splitMenu->addAction( tr( "Every N Seconds..." ), this,
+		[this] ()
+		{
+			bool ok = false;
+			const double secs = QInputDialog::getDouble( this, tr( "Split GIF..." ),
+				tr( "Length of segment in seconds:" ), 10.0, 0.1, 3600.0, 1, &ok );
+
+			if( !ok )
+				return;
+
+			// Segment starts with the frame shown at the time of cut.
+			const auto step = qMax( qint64( 1 ), qRound64( secs * 1000.0 ) );
+			QVector< int > cuts;
+
+			for( qint64 t = step; t < d->m_model->duration(); t += step )
+			{
+				const int idx = d->m_model->frameAt( t );
+
+				if( idx >= 0 )
+					cuts.push_back( idx );
+			}
+
+			d->split( cuts );
+		} );
+	d->m_splitMenu->addAction( tr( "At Frames..." ), this,
+		[this] ()
+		{
+			bool ok = false;
+			const auto text = QInputDialog::getText( this, tr( "Split GIF..." ),
+				tr( "Numbers of frames that start segments, separated by commas:" ),
+				QLineEdit::Normal, QString(), &ok );
+
+			if( !ok )
+				return;
+
+			QVector< int > cuts;
+
+			for( const auto & part : text.split( QLatin1Char( ',' ), Qt::SkipEmptyParts ) )
+			{
+				bool number = false;
+				const int counter = part.trimmed().toInt( &number );
+
+				if( !number || counter < 1 || counter > d->m_model->count() )
+				{
+					QMessageBox::warning( this, tr( "Split GIF..." ),
+						tr( "\"%1\" isn't a number of frame." ).arg( part.trimmed() ) );
+
+					return;
+				}
+
+				cuts.push_back( counter - 1 );
+			}
+
+			d->split( cuts );
+		} );
+	d->m_splitMenu->addAction( tr( "At Scene Cuts..." ), this,
+		[this] ()
+		{
+			bool ok = false;
+			const double percent = QInputDialog::getDouble( this, tr( "Split GIF..." ),
+				tr( "Start segment at frames that differ from the previous one in, % of pixels:" ),
+				30.0, 0.0, 100.0, 1, &ok );
+
+			if( ok )
+				d->split( QVector< int > (), percent );
+		} );
+	file->addSeparator();
+	d->m_cancelJob = file->addAction( tr( "Cancel" ), this, [this] () { d->m_job->cancel(); } );
+	d->m_cancelJob->setShortcut( Qt::Key_Escape );
+	d->m_cancelJob->setShortcutContext( Qt::ApplicationShortcut );
+	d->m_cancelJob->setEnabled( false );
+	file->addSeparator();
 	d->m_quit = file->addAction( QIcon( QStringLiteral( ":/img/application-exit.png" ) ), tr( "Quit" ),
 		tr( "Ctrl+Q" ), this, &MainWindow::quit );
 
 	d->m_save->setEnabled( false );
 	d->m_saveAs->setEnabled( false );
+	d->m_append->setEnabled( false );
+	d->m_splitMenu->setEnabled( false );
 
 	d->m_crop = new QAction( QIcon( QStringLiteral( ":/img/transform-crop.png" ) ),
 		tr( "Crop" ), this );
@@ -391,6 +1165,12 @@ MainWindow::MainWindow()
 	addAction( d->m_cancelEdit );
 
 	d->m_playTimer = new QTimer( this );
+	d->m_playTimer->setSingleShot( true );
+	d->m_playTimer->setTimerType( Qt::PreciseTimer );
+
+	d->m_progressTimer->setInterval( 250 );
+
+	connect( d->m_progressTimer, &QTimer::timeout, this, [this] () { d->showProgress(); } );
 
 	connect( d->m_crop, &QAction::triggered, this, &MainWindow::crop );
 	connect( d->m_playStop, &QAction::triggered, this, &MainWindow::playStop );
@@ -398,8 +1178,182 @@ MainWindow::MainWindow()
 	connect( d->m_cancelEdit, &QAction::triggered, this, &MainWindow::cancelEdit );
 	connect( d->m_playTimer, &QTimer::timeout, this, &MainWindow::showNextFrame );
 
+	auto undo = d->m_undoStack->createUndoAction( this, tr( "Undo" ) );
+	undo->setShortcut( QKeySequence::Undo );
+	auto redo = d->m_undoStack->createRedoAction( this, tr( "Redo" ) );
+	redo->setShortcut( QKeySequence::Redo );
+
+	connect( d->m_undoStack, &QUndoStack::indexChanged, this, &MainWindow::editsChanged );
+	connect( d->m_undoStack, &QUndoStack::cleanChanged, this,
+		[this] () { d->updateModified(); } );
+
 	auto edit = menuBar()->addMenu( tr( "&Edit" ) );
+	edit->addAction( undo );
+	edit->addAction( redo );
+	edit->addSeparator();
 	edit->addAction( d->m_crop );
+	edit->addAction( tr( "Set Delay..." ), this,
+		[this] ()
+		{
+			const auto * current = d->m_view->tape()->currentFrame();
+
+			if( !current || !d->m_model->checkedCount() )
+				return;
+
+			bool ok = false;
+			const int delay = QInputDialog::getInt( this, tr( "Set Delay..." ),
+				tr( "Delay of checked frames in milliseconds:" ),
+				d->m_model->delay( current->counter() - 1 ), 0, 655350, 10, &ok );
+
+			if( ok )
+				d->m_model->setDelay( d->m_model->checkedIndices(), delay );
+		} );
+	edit->addSeparator();
+	edit->addAction( tr( "Move Frame Left" ), tr( "Ctrl+Left" ), this,
+		[this] ()
+		{
+			if( const auto * current = d->m_view->tape()->currentFrame() )
+				d->moveFrames( current->counter(), 1, current->counter() - 1 );
+		} );
+	edit->addAction( tr( "Move Frame Right" ), tr( "Ctrl+Right" ), this,
+		[this] ()
+		{
+			if( const auto * current = d->m_view->tape()->currentFrame() )
+				d->moveFrames( current->counter(), 1, current->counter() + 1 );
+		} );
+	edit->addAction( tr( "Move Frames..." ), this,
+		[this] ()
+		{
+			const auto * current = d->m_view->tape()->currentFrame();
+
+			if( !current )
+				return;
+
+			const int first = current->counter();
+			const int c = d->m_view->tape()->count();
+			bool ok = false;
+			const int count = QInputDialog::getInt( this, tr( "Move Frames..." ),
+				tr( "Count of frames starting from #%1:" ).arg( first ),
+				1, 1, c - first + 1, 1, &ok );
+
+			if( !ok )
+				return;
+
+			const int to = QInputDialog::getInt( this, tr( "Move Frames..." ),
+				tr( "Move frames #%1-#%2 to start at #:" ).arg( first ).arg( first + count - 1 ),
+				c - count + 1, 1, c - count + 1, 1, &ok );
+
+			if( ok )
+				d->moveFrames( first, count, to );
+		} );
+	edit->addAction( tr( "Reverse" ), this,
+		[this] ()
+		{
+			QVector< qsizetype > order;
+			order.reserve( d->m_doc.count() );
+
+			for( auto i = d->m_doc.count() - 1; i >= 0; --i )
+				order.push_back( i );
+
+			d->rearrange( order );
+		} );
+	edit->addAction( tr( "Ping-Pong" ), this,
+		[this] ()
+		{
+			const auto c = d->m_doc.count();
+
+			if( c < 3 )
+				return;
+
+			// Forth and back without repeating of the last and the first frames on turns.
+			QVector< qsizetype > order;
+			order.reserve( c * 2 - 2 );
+
+			for( qsizetype i = 0; i < c; ++i )
+				order.push_back( i );
+
+			for( auto i = c - 2; i > 0; --i )
+				order.push_back( i );
+
+			d->rearrange( order );
+		} );
+	edit->addSeparator();
+	edit->addAction( tr( "Go to Time..." ), tr( "Ctrl+G" ), this,
+		[this] ()
+		{
+			if( !d->m_model->duration() )
+				return;
+
+			const auto * current = d->m_view->tape()->currentFrame();
+			bool ok = false;
+			const double secs = QInputDialog::getDouble( this, tr( "Go to Time..." ),
+				tr( "Time in seconds:" ),
+				current ? d->m_model->startTime( current->counter() - 1 ) / 1000.0 : 0.0,
+				0.0, ( d->m_model->duration() - 1 ) / 1000.0, 2, &ok );
+
+			if( !ok )
+				return;
+
+			const int idx = d->m_model->frameAt( static_cast< qint64 > ( secs * 1000.0 ) );
+
+			if( idx >= 0 )
+			{
+				d->m_view->tape()->setCurrentFrame( idx + 1 );
+				d->m_view->scrollTo( idx + 1 );
+			}
+		} );
+
+	d->m_selectMenu = menuBar()->addMenu( tr( "&Select" ) );
+	d->m_selectMenu->addAction( QIcon( QStringLiteral( ":/img/list-add.png" ) ), tr( "Check All" ),
+		this, [this] () { d->m_model->setChecked( 0, d->m_model->count() - 1, true ); } );
+	d->m_selectMenu->addAction( QIcon( QStringLiteral( ":/img/list-remove.png" ) ), tr( "Uncheck All" ),
+		this, [this] () { d->m_model->setChecked( 0, d->m_model->count() - 1, false ); } );
+	d->m_selectMenu->addAction( tr( "Invert" ), this, [this] () { d->m_model->invert(); } );
+	d->m_selectMenu->addSeparator();
+	d->m_selectMenu->addAction( tr( "Check Every Nth Frame..." ), this,
+		[this] ()
+		{
+			bool ok = false;
+			const int n = QInputDialog::getInt( this, tr( "Check Every Nth Frame..." ),
+				tr( "Check every Nth frame, uncheck the others, N:" ), 2, 1,
+				qMax( 1, d->m_model->count() ), 1, &ok );
+
+			if( ok )
+				d->m_model->checkEveryNth( n );
+		} );
+	d->m_selectMenu->addAction( tr( "Check by Delay..." ), this,
+		[this] ()
+		{
+			const auto * current = d->m_view->tape()->currentFrame();
+			const int delay = ( current ? d->m_model->delay( current->counter() - 1 ) : 0 );
+			bool ok = false;
+			const int minDelay = QInputDialog::getInt( this, tr( "Check by Delay..." ),
+				tr( "Minimal delay in milliseconds:" ), delay, 0, 655350, 10, &ok );
+
+			if( !ok )
+				return;
+
+			const int maxDelay = QInputDialog::getInt( this, tr( "Check by Delay..." ),
+				tr( "Maximal delay in milliseconds:" ), qMax( delay, minDelay ), minDelay,
+				655350, 10, &ok );
+
+			if( ok )
+				d->m_model->checkByDelay( minDelay, maxDelay );
+		} );
+	d->m_selectMenu->addAction( tr( "Uncheck Similar Frames..." ), this,
+		[this] ()
+		{
+			bool ok = false;
+			const double percent = QInputDialog::getDouble( this, tr( "Uncheck Similar Frames..." ),
+				tr( "Uncheck frames that differ from the previous one in less than, % of pixels:" ),
+				1.0, 0.0, 100.0, 1, &ok );
+
+			if( ok )
+				d->uncheckSimilar( percent );
+		} );
+	d->m_selectMenu->addSeparator();
+	d->m_selectMenu->addAction( tr( "Delete Unchecked Frames" ), QKeySequence::Delete, this,
+		[this] () { d->deleteUnchecked(); } );
 
 	d->m_editToolBar = new QToolBar( tr( "Tools" ), this );
 	d->m_editToolBar->addAction( d->m_playStop );
@@ -410,6 +1364,30 @@ MainWindow::MainWindow()
 
 	d->m_editToolBar->hide();
 
+	d->m_metrics = new MetricsDock( d->m_doc, this );
+	addDockWidget( Qt::RightDockWidgetArea, d->m_metrics );
+	d->m_metrics->hide();
+
+	auto view = menuBar()->addMenu( tr( "&View" ) );
+	view->addAction( tr( "Previous Frame" ), QKeySequence( Qt::Key_Left ), this,
+		[this] ()
+		{
+			const auto * current = d->m_view->tape()->currentFrame();
+			d->goToFrame( current ? current->counter() - 1 : 1 );
+		} );
+	view->addAction( tr( "Next Frame" ), QKeySequence( Qt::Key_Right ), this,
+		[this] ()
+		{
+			const auto * current = d->m_view->tape()->currentFrame();
+			d->goToFrame( current ? current->counter() + 1 : 1 );
+		} );
+	view->addAction( tr( "First Frame" ), QKeySequence( Qt::Key_Home ), this,
+		[this] () { d->goToFrame( 1 ); } );
+	view->addAction( tr( "Last Frame" ), QKeySequence( Qt::Key_End ), this,
+		[this] () { d->goToFrame( d->m_view->tape()->count() ); } );
+	view->addSeparator();
+	view->addAction( d->m_metrics->toggleViewAction() );
+
 	auto help = menuBar()->addMenu( tr( "&Help" ) );
 	help->addAction( QIcon( QStringLiteral( ":/img/icon_22x22.png" ) ), tr( "About" ),
 		this, &MainWindow::about );
@@ -424,8 +1402,21 @@ MainWindow::MainWindow()
 
 	setCentralWidget( d->m_stack );
 
-	connect( d->m_view->tape(), &Tape::checkStateChanged,
+	d->m_view->tape()->setModel( d->m_model );
+
+	connect( d->m_view->tape(), &Tape::moveRequested, this,
+		[this] ( int idx, int to ) { d->moveFrames( idx, 1, to ); } );
+
+	connect( d->m_model, &FrameModel::checkedChanged,
 		this, &MainWindow::frameChecked );
+	connect( d->m_model, &FrameModel::delaysChanged, this,
+		[this] ()
+		{
+			d->setModified( true );
+
+			if( d->m_playing )
+				d->startPlayback();
+		} );
 }
 
 MainWindow::~MainWindow() noexcept
@@ -435,20 +1426,29 @@ MainWindow::~MainWindow() noexcept
 void
 MainWindow::closeEvent( QCloseEvent * e )
 {
+	if( d->m_quitFlag )
+	{
+		e->accept();
+
+		return;
+	}
+
+	e->ignore();
+
 	if ( d->m_busyFlag )
 	{
 		const auto btn = QMessageBox::question( this, tr( "GIF editor is busy..." ),
-			tr( "GIF editor is busy.\nDo you want to terminate the application?" ) );
+			tr( "GIF editor is busy.\nDo you want to cancel the operation and quit?" ) );
 
 		if( btn == QMessageBox::Yes )
-			exit( -1 );
-		else
-			e->ignore();
+		{
+			d->m_quitFlag = true;
+
+			d->m_job->cancel();
+		}
 	}
 	else
-		e->accept();
-
-	quit();
+		quit();
 }
 
 void
@@ -472,101 +1472,21 @@ MainWindow::openGif()
 					"Do you want to save it?" ).arg( fileName ) );
 
 			if( btn == QMessageBox::Yes )
-				saveGif();
-		}
+			{
+				d->save( [this, fileName] () { d->openGif( fileName ); } );
 
-		d->busy();
+				return;
+			}
+		}
 
 		d->openGif( fileName );
-
-		d->ready();
 	}
 }
 
-namespace /* anonymous */ {
-
-class WriteGIF final
-	:	public QRunnable
-{
-public:
-	WriteGIF( BusyIndicator * receiver,
-		const QStringList & files,
-		const QVector< int > & delays,
-		const QString & fileName )
-		:	m_files( files )
-		,	m_delays( delays )
-		,	m_fileName( fileName )
-		,	m_receiver( receiver )
-	{
-		setAutoDelete( false );
-	}
-
-	void run() override
-	{			
-		QGifLib::Gif gif;
-		
-		QObject::connect( &gif, &QGifLib::Gif::writeProgress,
-			m_receiver, &BusyIndicator::setPercent );
-		
-		gif.write( m_fileName, m_files, m_delays, 0 );
-	}
-
-private:
-	const QStringList & m_files;
-	const QVector< int > & m_delays;
-	QString m_fileName;
-	BusyIndicator * m_receiver;
-}; // class WriteGIF
-
-} /* namespace anonymous */
-
 void
 MainWindow::saveGif()
 {
-	try {
-		d->busy();
-
-		QStringList toSave;
-		QVector< int > delays;
-		const auto allFiles = d->m_frames.fileNames();
-
-		for( int i = 0; i < d->m_view->tape()->count(); ++i )
-		{
-			if( d->m_view->tape()->frame( i + 1 )->isChecked() )
-			{
-				toSave.push_back( allFiles.at( i ) );
-				delays.push_back( d->m_frames.delay( i ) );
-			}
-		}
-
-		if( !toSave.empty() )
-		{
-			d->m_busy->setShowPercent( true );
-			
-			WriteGIF runnable( d->m_busy, toSave, delays, d->m_currentGif );
-			QThreadPool::globalInstance()->start( &runnable );
-
-			d->waitThreadPool();
-			
-			d->m_busy->setShowPercent( false );
-
-			d->openGif( d->m_currentGif );
-		}
-		else
-		{
-			QMessageBox::information( this, tr( "Can't save GIF..." ),
-				tr( "Can't save GIF image with no frames." ) );
-		}
-
-		d->ready();
-	}
-	catch( const std::bad_alloc & )
-	{
-		d->ready();
-
-		QMessageBox::critical( this, tr( "Failed to save GIF..." ),
-			tr( "Out of memory." ) );
-	}
+	d->save();
 }
 
 void
@@ -580,7 +1500,7 @@ MainWindow::saveGifAs()
 		if( !fileName.endsWith( QStringLiteral( ".gif" ), Qt::CaseInsensitive ) )
 			fileName.append( QStringLiteral( ".gif" ) );
 
-		d->m_currentGif = fileName;
+		d->m_doc.setFileName( fileName );
 
 		QFileInfo info( fileName );
 
@@ -601,7 +1521,16 @@ MainWindow::quit()
 				tr( "GIF was changed. Do you want to save changes?" ) );
 
 			if( btn == QMessageBox::Yes )
-				saveGif();
+			{
+				d->save( [this] ()
+					{
+						d->m_quitFlag = true;
+
+						QApplication::quit();
+					} );
+
+				return;
+			}
 		}
 
 		d->m_quitFlag = true;
@@ -611,9 +1540,22 @@ MainWindow::quit()
 }
 
 void
-MainWindow::frameChecked( int, bool )
+MainWindow::frameChecked( int, int )
 {
 	d->setModified( true );
+
+	if( d->m_playing )
+		d->startPlayback();
+}
+
+void
+MainWindow::editsChanged()
+{
+	if( d->m_playing )
+		d->startPlayback();
+
+	d->m_view->currentFrame()->invalidate();
+	d->m_view->tape()->invalidate();
 }
 
 void
@@ -668,51 +1610,25 @@ MainWindow::applyEdit()
 	{
 		case MainWindowPrivate::EditMode::Crop :
 		{
+			TRACE_SPAN( "crop" );
+
 			const auto rect = d->m_view->cropRect();
 
 			if( !rect.isNull() && rect != d->m_view->currentFrame()->imageRect() )
 			{
-				d->busy();
-
-				QVector< int > unchecked;
-
-				for( int i = 1; i <= d->m_view->tape()->count(); ++i )
-				{
-					if( !d->m_view->tape()->frame( i )->isChecked() )
-						unchecked.append( i );
-				}
-
-				QApplication::processEvents();
-				
-				d->m_busy->setShowPercent( true );
-
-				CropGIF crop( d->m_busy, &d->m_frames, rect );
-				QThreadPool::globalInstance()->start( &crop );
-
-				d->waitThreadPool();
-				
-				d->m_busy->setShowPercent( false );
+				QElapsedTimer timer;
+				timer.start();
 
-				const auto current = d->m_view->tape()->currentFrame()->counter();
-				d->m_view->tape()->clear();
+				d->m_undoStack->push( new EditCommand( d->m_doc.edits(),
+					EditOperation::crop( rect ), tr( "Crop" ) ) );
 
-				QApplication::processEvents();
+				// Render of the current frame is the visible cost of crop.
+				d->m_view->currentFrame()->repaint();
 
-				d->initTape();
-
-				d->m_view->tape()->setCurrentFrame( current );
-
-				for( const auto & i : std::as_const( unchecked ) )
-					d->m_view->tape()->frame( i )->setChecked( false );
-
-				d->setModified( true );
-
-				cancelEdit();
-
-				d->ready();
+				Metrics::set( Metrics::instance().m_lastCropMsecs, timer.elapsed() );
 			}
-			else
-				cancelEdit();
+
+			cancelEdit();
 		}
 			break;
 
@@ -1170,38 +2086,77 @@ void
 MainWindow::playStop()
 {
 	if( d->m_playing )
-	{
-		d->m_playTimer->stop();
-		d->m_playStop->setText( tr( "Play" ) );
-		d->m_playStop->setIcon( QIcon( ":/img/media-playback-start.png" ) );
-	}
+		d->stopPlayback();
 	else
 	{
 		d->m_playStop->setText( tr( "Stop" ) );
 		d->m_playStop->setIcon( QIcon( ":/img/media-playback-stop.png" ) );
-		const auto & img = d->m_view->tape()->currentFrame()->image();
-		d->m_playTimer->start( static_cast< int >( img.m_gif.delay( img.m_pos ) ) );
+		d->startPlayback();
+		d->m_playing = true;
 	}
-
-	d->m_playing = !d->m_playing;
 }
 
 void
 MainWindow::showNextFrame()
 {
-	const auto next = d->nextCheckedFrame( d->m_view->tape()->currentFrame()->counter() );
+	const auto tick = d->m_playback.tick();
+
+	if( tick.m_frame < 0 )
+		return;
 
-	if( next != -1 )
+	// Timer woke up before the next frame.
+	if( tick.m_sequence <= d->m_playback.lastPresented() )
 	{
-		const auto nextDelay = d->nextCheckedFrame( next );
+		d->m_playTimer->start( static_cast< int > ( qMax( Q_INT64_C( 1 ), tick.m_wait ) ) );
 
-		if( nextDelay != -1 )
-		{
-			const auto & img = d->m_view->tape()->frame( nextDelay )->image();
-			d->m_playTimer->start( d->m_frames.delay( img.m_pos ) );
-		}
+		return;
+	}
+
+	// View was resized, frames are rendered for the new size from now.
+	if( d->m_renderer.size() != d->m_view->currentFrame()->fitSize() )
+	{
+		QVector< qsizetype > positions;
+		positions.reserve( d->m_playFrames.size() );
 
+		for( const auto & counter : std::as_const( d->m_playFrames ) )
+			positions.push_back( counter - 1 );
+
+		d->m_renderer.start( d->m_doc, positions, d->m_view->currentFrame()->fitSize(),
+			tick.m_sequence );
+	}
+
+	const auto next = d->m_playFrames.at( tick.m_frame );
+
+	// Nothing to render to, e.g. view is collapsed, frame is shown as usual.
+	if( !d->m_renderer.isRunning() )
+	{
+		d->m_playTimer->start( static_cast< int > ( qMax( Q_INT64_C( 1 ), tick.m_wait ) ) );
+		d->m_playback.present( tick.m_sequence );
 		d->m_view->tape()->setCurrentFrame( next );
 		d->m_view->scrollTo( next );
+		d->showPlaybackStats();
+
+		return;
 	}
+
+	const auto img = d->m_renderer.take( tick.m_sequence );
+
+	if( img.isNull() )
+	{
+		// Frame is not rendered yet, it's better to show it a bit late than to drop it.
+		d->m_playTimer->start( static_cast< int > ( qBound( Q_INT64_C( 1 ), tick.m_wait,
+			Q_INT64_C( 4 ) ) ) );
+
+		return;
+	}
+
+	// Timer is armed before drawing, so drawing doesn't delay the next frame.
+	d->m_playTimer->start( static_cast< int > ( qMax( Q_INT64_C( 1 ), tick.m_wait ) ) );
+
+	d->m_playback.present( tick.m_sequence );
+
+	d->m_view->showFrame( next, img );
+	d->m_view->scrollTo( next );
+
+	d->showPlaybackStats();
 }
@@ -56,8 +56,10 @@ private slots:
 	void saveGifAs();
 	//! Quit.
 	void quit();
-	//! Frame checked/unchecked.
-	void frameChecked( int idx, bool on );
+	//! Frames in range [first, last] checked/unchecked.
+	void frameChecked( int first, int last );
+	//! Edits were changed, done, undone or redone.
+	void editsChanged();
 	//! Crop.
 	void crop( bool on );
 	//! Cancel edit.
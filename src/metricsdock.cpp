@@ -0,0 +1,227 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GIF editor include.
+#include "metricsdock.hpp"
+#include "core/document.hpp"
+#include "core/metrics.hpp"
+#include "core/scheduler.hpp"
+#include "core/watchdog.hpp"
+
+// Qt include.
+#include <QFormLayout>
+#include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+
+
+//
+// MetricsDockPrivate
+//
+
+class MetricsDockPrivate {
+public:
+	MetricsDockPrivate( const Document & doc, MetricsDock * parent )
+		:	m_doc( doc )
+		,	m_timer( new QTimer( parent ) )
+		,	q( parent )
+	{
+	}
+
+	//! Init.
+	void init();
+	//! Sample metrics.
+	void refresh();
+
+	//! \return Label added to the form.
+	QLabel * addRow( QFormLayout * form, const QString & name )
+	{
+		auto * label = new QLabel( form->parentWidget() );
+		label->setTextInteractionFlags( Qt::TextSelectableByMouse );
+		form->addRow( name, label );
+
+		return label;
+	}
+
+	//! \return Hit rate text.
+	static QString hitRate( qint64 hits, qint64 misses )
+	{
+		const auto all = hits + misses;
+
+		return ( all > 0 ? QStringLiteral( "%1%" ).arg( hits * 100.0 / all, 0, 'f', 1 ) :
+			QStringLiteral( "-" ) );
+	}
+
+	//! \return Megabytes text.
+	static QString megabytes( qint64 bytes )
+	{
+		return QStringLiteral( "%1 MB" ).arg( bytes / 1024.0 / 1024.0, 0, 'f', 1 );
+	}
+
+	//! \return Duration text.
+	static QString duration( qint64 msecs )
+	{
+		return ( msecs >= 0 ? QStringLiteral( "%1 ms" ).arg( msecs ) : QStringLiteral( "-" ) );
+	}
+
+	//! Document.
+	const Document & m_doc;
+	//! Refresh timer.
+	QTimer * m_timer;
+	//! Time since the previous sample.
+	QElapsedTimer m_elapsed;
+	//! Decoded frames at the previous sample.
+	qint64 m_prevDecoded = 0;
+	//! Decoded frames per second.
+	QLabel * m_decodeRate = nullptr;
+	//! Hit rate of frames cache.
+	QLabel * m_frameHits = nullptr;
+	//! Size of frames cache.
+	QLabel * m_frameCache = nullptr;
+	//! Hit rate of thumbnails.
+	QLabel * m_thumbnailHits = nullptr;
+	//! Size of thumbnails.
+	QLabel * m_thumbnails = nullptr;
+	//! Thread pool.
+	QLabel * m_threads = nullptr;
+	//! Queued jobs.
+	QLabel * m_queued = nullptr;
+	//! Last load.
+	QLabel * m_load = nullptr;
+	//! Last crop.
+	QLabel * m_crop = nullptr;
+	//! Last save.
+	QLabel * m_save = nullptr;
+	//! Stalls of UI.
+	QLabel * m_stalls = nullptr;
+	//! Parent.
+	MetricsDock * q;
+}; // class MetricsDockPrivate
+
+void
+MetricsDockPrivate::init()
+{
+	auto * w = new QWidget( q );
+	auto * form = new QFormLayout( w );
+
+	m_decodeRate = addRow( form, MetricsDock::tr( "Decoded frames/s:" ) );
+	m_frameHits = addRow( form, MetricsDock::tr( "Frame cache hits:" ) );
+	m_frameCache = addRow( form, MetricsDock::tr( "Frame cache:" ) );
+	m_thumbnailHits = addRow( form, MetricsDock::tr( "Thumbnail hits:" ) );
+	m_thumbnails = addRow( form, MetricsDock::tr( "Thumbnails:" ) );
+	m_threads = addRow( form, MetricsDock::tr( "Active threads:" ) );
+	m_queued = addRow( form, MetricsDock::tr( "Queued jobs:" ) );
+	m_load = addRow( form, MetricsDock::tr( "Last load:" ) );
+	m_crop = addRow( form, MetricsDock::tr( "Last crop:" ) );
+	m_save = addRow( form, MetricsDock::tr( "Last save:" ) );
+	m_stalls = addRow( form, MetricsDock::tr( "UI stalls:" ) );
+	m_stalls->setWordWrap( true );
+
+	q->setWidget( w );
+	q->setObjectName( QStringLiteral( "metrics" ) );
+
+	m_timer->setInterval( 1000 );
+
+	QObject::connect( m_timer, &QTimer::timeout, q, [this] () { refresh(); } );
+}
+
+void
+MetricsDockPrivate::refresh()
+{
+	const auto & m = Metrics::instance();
+
+	const auto decoded = Metrics::get( m.m_framesDecoded );
+	const auto msecs = ( m_elapsed.isValid() ? m_elapsed.restart() : 0 );
+
+	if( !m_elapsed.isValid() )
+		m_elapsed.start();
+
+	m_decodeRate->setText( msecs > 0 ?
+		QString::number( ( decoded - m_prevDecoded ) * 1000.0 / msecs, 'f', 1 ) :
+		QStringLiteral( "-" ) );
+	m_prevDecoded = decoded;
+
+	m_frameHits->setText( hitRate( Metrics::get( m.m_frameCacheHits ),
+		Metrics::get( m.m_frameCacheMisses ) ) );
+	m_frameCache->setText( MetricsDock::tr( "%1 of %2 in %3 frames" )
+		.arg( megabytes( m_doc.frames().cacheSize() ),
+			megabytes( m_doc.frames().cacheLimit() ) )
+		.arg( m_doc.frames().cachedCount() ) );
+	m_thumbnailHits->setText( hitRate( Metrics::get( m.m_thumbnailHits ),
+		Metrics::get( m.m_thumbnailMisses ) ) );
+	m_thumbnails->setText( megabytes( Metrics::get( m.m_thumbnailBytes ) ) );
+
+	const auto & scheduler = Scheduler::instance();
+
+	m_threads->setText( QStringLiteral( "%1 / %2" ).arg( scheduler.activeCount() )
+		.arg( scheduler.threadCount() ) );
+	m_queued->setText( MetricsDock::tr( "%1 (interactive %2, thumbnails %3, "
+			"prefetch %4, background %5)" )
+		.arg( scheduler.queuedCount() )
+		.arg( scheduler.queuedCount( Scheduler::Priority::Interactive ) )
+		.arg( scheduler.queuedCount( Scheduler::Priority::Thumbnail ) )
+		.arg( scheduler.queuedCount( Scheduler::Priority::Prefetch ) )
+		.arg( scheduler.queuedCount( Scheduler::Priority::Background ) ) );
+
+	m_load->setText( duration( Metrics::get( m.m_lastLoadMsecs ) ) );
+	m_crop->setText( duration( Metrics::get( m.m_lastCropMsecs ) ) );
+	m_save->setText( duration( Metrics::get( m.m_lastSaveMsecs ) ) );
+
+	const auto stalls = Watchdog::summary();
+
+	m_stalls->setText( stalls.isEmpty() ? QStringLiteral( "-" ) : stalls );
+}
+
+
+//
+// MetricsDock
+//
+
+MetricsDock::MetricsDock( const Document & doc, QWidget * parent )
+	:	QDockWidget( tr( "Performance" ), parent )
+	,	d( new MetricsDockPrivate( doc, this ) )
+{
+	d->init();
+}
+
+MetricsDock::~MetricsDock() noexcept
+{
+}
+
+void
+MetricsDock::showEvent( QShowEvent * e )
+{
+	d->m_elapsed.invalidate();
+	d->m_prevDecoded = Metrics::get( Metrics::instance().m_framesDecoded );
+	d->refresh();
+	d->m_timer->start();
+
+	QDockWidget::showEvent( e );
+}
+
+void
+MetricsDock::hideEvent( QHideEvent * e )
+{
+	d->m_timer->stop();
+
+	QDockWidget::hideEvent( e );
+}
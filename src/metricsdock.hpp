@@ -0,0 +1,67 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2026 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GIF_EDITOR_METRICSDOCK_HPP_INCLUDED
+#define GIF_EDITOR_METRICSDOCK_HPP_INCLUDED
+
+// Qt include.
+#include <QDockWidget>
+#include <QScopedPointer>
+
+
+class Document;
+
+
+//
+// MetricsDock
+//
+
+class MetricsDockPrivate;
+
+/*!
+	Dock with live metrics of the engine: decoding rate, caches,
+	thread pool, durations of the last operations and stalls of UI.
+
+	Metrics are sampled once a second while the dock is visible.
+*/
+class MetricsDock final
+	:	public QDockWidget
+{
+	Q_OBJECT
+
+public:
+	explicit MetricsDock( const Document & doc, QWidget * parent = nullptr );
+	~MetricsDock() noexcept override;
+
+protected:
+	void showEvent( QShowEvent * e ) override;
+	void hideEvent( QHideEvent * e ) override;
+
+private:
+	friend class MetricsDockPrivate;
+
+	Q_DISABLE_COPY( MetricsDock )
+
+	QScopedPointer< MetricsDockPrivate > d;
+}; // class MetricsDock
+
+#endif // GIF_EDITOR_METRICSDOCK_HPP_INCLUDED
@@ -23,14 +23,22 @@
 // GIF editor include.
 #include "tape.hpp"
 #include "frameontape.hpp"
+#include "core/framemodel.hpp"
 
 // Qt include.
 #include <QList>
 #include <QHBoxLayout>
-#include <QApplication>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QDragEnterEvent>
+#include <QDragMoveEvent>
+#include <QDropEvent>
+#include <QMimeData>
 
 // C++ include.
 #include <utility>
+#include <iterator>
+#include <algorithm>
 
 
 //
@@ -41,14 +49,56 @@ class TapePrivate {
 public:
 	TapePrivate( Tape * parent )
 		:	m_currentFrame( nullptr )
+		,	m_model( nullptr )
 		,	m_layout( new QHBoxLayout( parent ) )
 		,	q( parent )
 	{
 		m_layout->setContentsMargins( q->spacing(), q->spacing(),
-			q->spacing(), q->spacing() );
+			q->spacing(), q->spacing() + rulerHeight() );
 		m_layout->setSpacing( q->spacing() );
 	}
 
+	//! \return Height of time ruler.
+	int rulerHeight() const
+	{
+		return q->fontMetrics().height() + 4;
+	}
+
+	//! \return Interval between ticks of ruler in milliseconds for \a pixelsPerMsec.
+	static qint64 rulerInterval( double pixelsPerMsec )
+	{
+		static const qint64 intervals[] = { 100, 250, 500, 1000, 2000, 5000,
+			10000, 15000, 30000, 60000, 120000, 300000, 600000 };
+
+		for( const auto & i : intervals )
+		{
+			if( i * pixelsPerMsec >= 80.0 )
+				return i;
+		}
+
+		return intervals[ std::size( intervals ) - 1 ];
+	}
+
+	//! \return Text of time.
+	static QString timeText( qint64 msecs, qint64 interval )
+	{
+		const auto text = QStringLiteral( "%1:%2" ).arg( msecs / 60000 )
+			.arg( ( msecs / 1000 ) % 60, 2, 10, QLatin1Char( '0' ) );
+
+		return ( interval % 1000 ? text + QStringLiteral( ".%1" ).arg( ( msecs % 1000 ) / 100 ) :
+			text );
+	}
+
+	//! \return Is \a e a drag of frame of this tape?
+	bool isFrameDrag( QDropEvent * e ) const
+	{
+		return ( e->mimeData()->hasFormat( FrameOnTape::mimeType() ) &&
+			m_frames.contains( qobject_cast< FrameOnTape* > ( e->source() ) ) );
+	}
+
+	//! \return New frame widget with the given counter.
+	FrameOnTape * createFrame( const ImageRef & img, int counter );
+
 	void clearImages()
 	{
 		for( auto & f : std::as_const( m_frames ) )
@@ -59,12 +109,48 @@ public:
 	QList< FrameOnTape* > m_frames;
 	//! Current frame.
 	FrameOnTape * m_currentFrame;
+	//! Model.
+	FrameModel * m_model;
 	//! Layout.
 	QHBoxLayout * m_layout;
 	//! Parent.
 	Tape * q;
 }; // class TapePrivate
 
+FrameOnTape *
+TapePrivate::createFrame( const ImageRef & img, int counter )
+{
+	auto * f = new FrameOnTape( img, counter,
+		q->height() - m_layout->contentsMargins().bottom() - m_layout->contentsMargins().top(),
+		q );
+
+	QObject::connect( f, &FrameOnTape::checkTillEnd, q, &Tape::checkTillEnd );
+
+	QObject::connect( f, &FrameOnTape::clicked, q,
+		[this] ( int idx )
+		{
+			if( q->currentFrame() )
+				q->currentFrame()->setCurrent( false );
+
+			m_currentFrame = q->frame( idx );
+
+			m_currentFrame->setCurrent( true );
+
+			emit q->currentFrameChanged( idx );
+
+			emit q->clicked( idx );
+		} );
+
+	QObject::connect( f, &FrameOnTape::checked, q,
+		[this] ( int idx, bool on )
+		{
+			if( m_model )
+				m_model->setChecked( idx - 1, on );
+		} );
+
+	return f;
+}
+
 
 //
 // Tape
@@ -74,47 +160,52 @@ Tape::Tape( QWidget * parent )
 	:	QWidget( parent )
 	,	d( new TapePrivate( this ) )
 {
+	setAcceptDrops( true );
 }
 
 Tape::~Tape() noexcept
 {
 }
 
-int
-Tape::count() const
+FrameModel *
+Tape::model() const
 {
-	return d->m_frames.count();
+	return d->m_model;
 }
 
 void
-Tape::addFrame( const ImageRef & img )
+Tape::setModel( FrameModel * model )
 {
-	d->m_frames.append( new FrameOnTape( img, count() + 1,
-		height() - d->m_layout->contentsMargins().bottom() - d->m_layout->contentsMargins().top(),
-		this ) );
-	connect( d->m_frames.back(), &FrameOnTape::checkTillEnd,
-		this, &Tape::checkTillEnd );
-	d->m_layout->addWidget( d->m_frames.back() );
+	if( d->m_model )
+		disconnect( d->m_model, nullptr, this, nullptr );
 
-	QApplication::processEvents();
+	d->m_model = model;
 
-	connect( d->m_frames.back(), &FrameOnTape::clicked, this,
-		[this] ( int idx )
-		{
-			if( this->currentFrame() )
-				this->currentFrame()->setCurrent( false );
-
-			this->d->m_currentFrame = this->frame( idx );
+	if( d->m_model )
+	{
+		connect( d->m_model, &FrameModel::checkedChanged,
+			this, &Tape::modelCheckedChanged );
+		connect( d->m_model, &FrameModel::delaysChanged,
+			this, qOverload<>( &Tape::update ) );
 
-			this->d->m_currentFrame->setCurrent( true );
+		modelCheckedChanged( 0, count() - 1 );
+	}
+}
 
-			emit this->currentFrameChanged( idx );
+int
+Tape::count() const
+{
+	return d->m_frames.count();
+}
 
-			emit this->clicked( idx );
-		} );
+void
+Tape::addFrame( const ImageRef & img )
+{
+	d->m_frames.append( d->createFrame( img, count() + 1 ) );
+	d->m_layout->addWidget( d->m_frames.back() );
 
-	connect( d->m_frames.back(), &FrameOnTape::checked,
-		this, &Tape::checkStateChanged );
+	if( d->m_model && count() <= d->m_model->count() )
+		d->m_frames.back()->setChecked( d->m_model->isChecked( count() - 1 ) );
 
 	adjustSize();
 }
@@ -200,7 +291,6 @@ Tape::clear()
 	{
 		d->m_layout->removeWidget( d->m_frames.at( i ) );
 		d->m_frames.at( i )->deleteLater();
-		QApplication::processEvents();
 	}
 
 	d->m_frames.clear();
@@ -213,29 +303,181 @@ Tape::clear()
 void
 Tape::removeUnchecked()
 {
-	const int c = count();
-	int removed = 0;
+	const int current = ( d->m_currentFrame ? d->m_currentFrame->counter() : 0 );
+	FrameOnTape * nearest = nullptr;
+	QList< FrameOnTape* > frames;
+	frames.reserve( count() );
+
+	setUpdatesEnabled( false );
 
-	for( int i = 1; i <= c; ++i )
+	// Frames are compacted and renumbered in one pass, thumbnails of the rest stay.
+	for( auto * f : std::as_const( d->m_frames ) )
 	{
-		if( !frame( i - removed )->isChecked() )
+		if( f->isChecked() )
 		{
-			removeFrame( i - removed );
+			if( current && ( !nearest || f->counter() <= current ) )
+				nearest = f;
+
+			f->moveImage( frames.size() );
+			f->setCounter( static_cast< int > ( frames.size() ) + 1 );
+			frames.push_back( f );
+		}
+		else
+		{
+			d->m_layout->removeWidget( f );
+			f->deleteLater();
+		}
+	}
+
+	std::swap( d->m_frames, frames );
+
+	setUpdatesEnabled( true );
+
+	adjustSize();
+
+	// Current frame is the same one or the nearest to it, but its index changed anyway.
+	d->m_currentFrame = nullptr;
+
+	if( nearest )
+		setCurrentFrame( nearest->counter() );
+	else
+		emit currentFrameChanged( 0 );
+}
+
+void
+Tape::moveFrames( int first, int count, int to )
+{
+	if( count <= 0 || first < 1 || first + count - 1 > this->count() || to < 1 ||
+		to > this->count() - count + 1 || to == first )
+			return;
+
+	const int lo = qMin( first, to ) - 1;
+	const int hi = qMax( first, to ) - 1 + count;
+	const int shift = ( to < first ? first - 1 - lo : count );
 
-			++removed;
+	setUpdatesEnabled( false );
 
-			QApplication::processEvents();
+	// Only frames between the old and the new place are touched.
+	for( int i = lo; i < hi; ++i )
+		d->m_layout->removeWidget( d->m_frames.at( i ) );
+
+	std::rotate( d->m_frames.begin() + lo, d->m_frames.begin() + lo + shift,
+		d->m_frames.begin() + hi );
+
+	for( int i = lo; i < hi; ++i )
+	{
+		auto * f = d->m_frames.at( i );
+		f->moveImage( i );
+		f->setCounter( i + 1 );
+
+		d->m_layout->insertWidget( i, f );
+	}
+
+	setUpdatesEnabled( true );
+
+	update();
+
+	if( d->m_currentFrame && d->m_currentFrame->counter() > lo &&
+		d->m_currentFrame->counter() <= hi )
+			emit currentFrameChanged( d->m_currentFrame->counter() );
+}
+
+void
+Tape::rearrange( const QVector< qsizetype > & order )
+{
+	if( !count() )
+		return;
+
+	const auto & doc = d->m_frames.front()->image().m_doc;
+	std::vector< bool > used( static_cast< size_t > ( count() ), false );
+	QList< FrameOnTape* > frames;
+	frames.reserve( order.size() );
+
+	setUpdatesEnabled( false );
+
+	for( auto * f : std::as_const( d->m_frames ) )
+		d->m_layout->removeWidget( f );
+
+	// The first occurrence of frame takes its widget with thumbnail,
+	// repeated ones get new widgets.
+	for( qsizetype i = 0; i < order.size(); ++i )
+	{
+		const auto pos = order.at( i );
+		FrameOnTape * f = nullptr;
+
+		if( !used[ pos ] )
+		{
+			used[ pos ] = true;
+			f = d->m_frames.at( pos );
+			f->moveImage( i );
+			f->setCounter( static_cast< int > ( i ) + 1 );
 		}
 		else
-			frame( i - removed )->setCounter( i - removed );
+			f = d->createFrame( { doc, i, false }, static_cast< int > ( i ) + 1 );
+
+		if( d->m_model && i < d->m_model->count() )
+			f->setChecked( d->m_model->isChecked( static_cast< int > ( i ) ) );
+
+		d->m_layout->addWidget( f );
+		frames.push_back( f );
+	}
+
+	for( qsizetype i = 0; i < count(); ++i )
+	{
+		if( !used[ i ] )
+		{
+			if( d->m_frames.at( i ) == d->m_currentFrame )
+				d->m_currentFrame = nullptr;
+
+			d->m_frames.at( i )->deleteLater();
+		}
 	}
+
+	std::swap( d->m_frames, frames );
+
+	setUpdatesEnabled( true );
+
+	adjustSize();
+
+	if( d->m_currentFrame )
+		emit currentFrameChanged( d->m_currentFrame->counter() );
+	else
+		setCurrentFrame( 1 );
+}
+
+void
+Tape::invalidate()
+{
+	for( auto & f : std::as_const( d->m_frames ) )
+		f->invalidate();
 }
 
 void
 Tape::checkTillEnd( int idx, bool on )
 {
-	for( int i = idx; i <= count(); ++i )
-		frame( i )->setChecked( on );
+	if( d->m_model )
+		d->m_model->setChecked( idx - 1, count() - 1, on );
+}
+
+void
+Tape::modelCheckedChanged( int first, int last )
+{
+	last = qMin( last, qMin( count(), d->m_model->count() ) - 1 );
+
+	// Batch of changes is repainted once.
+	const bool batch = ( last > first );
+
+	if( batch )
+		setUpdatesEnabled( false );
+
+	for( int i = qMax( 0, first ); i <= last; ++i )
+		d->m_frames.at( i )->setChecked( d->m_model->isChecked( i ) );
+
+	if( batch )
+		setUpdatesEnabled( true );
+
+	// Timeline of frames after the first changed one moved.
+	update();
 }
 
 int
@@ -253,3 +495,83 @@ Tape::spacing() const
 {
 	return 5;
 }
+
+void
+Tape::paintEvent( QPaintEvent * e )
+{
+	if( !d->m_model || !count() || d->m_model->count() < count() || !d->m_model->duration() )
+		return;
+
+	const auto & model = *d->m_model;
+	const int frameWidth = d->m_frames.front()->width();
+	const int step = frameWidth + d->m_layout->spacing();
+	const int left = d->m_layout->contentsMargins().left();
+	const int y = height() - d->rulerHeight();
+
+	// Only ticks of exposed frames are drawn.
+	const int first = qBound( 0, ( e->rect().left() - left ) / step, count() - 1 );
+	const int last = qBound( 0, ( e->rect().right() - left ) / step, count() - 1 );
+	const auto from = model.startTime( first );
+	const auto to = model.startTime( last + 1 );
+	const auto interval = TapePrivate::rulerInterval(
+		(double) step * model.checkedCount() / (double) model.duration() );
+
+	QPainter p( this );
+	p.setPen( palette().color( QPalette::WindowText ) );
+
+	for( auto t = ( from + interval - 1 ) / interval * interval; t < to; t += interval )
+	{
+		const int idx = model.frameAt( t );
+
+		if( idx < 0 )
+			break;
+
+		const auto start = model.startTime( idx );
+		const auto length = model.startTime( idx + 1 ) - start;
+		const int x = left + idx * step +
+			static_cast< int > ( (double) ( t - start ) * frameWidth / (double) length );
+
+		p.drawLine( x, y, x, y + 4 );
+		p.drawText( x + 2, y + 2 + p.fontMetrics().ascent(), TapePrivate::timeText( t, interval ) );
+	}
+}
+
+void
+Tape::dragEnterEvent( QDragEnterEvent * e )
+{
+	if( d->isFrameDrag( e ) )
+		e->acceptProposedAction();
+	else
+		e->ignore();
+}
+
+void
+Tape::dragMoveEvent( QDragMoveEvent * e )
+{
+	if( d->isFrameDrag( e ) )
+		e->acceptProposedAction();
+	else
+		e->ignore();
+}
+
+void
+Tape::dropEvent( QDropEvent * e )
+{
+	if( !d->isFrameDrag( e ) || !count() )
+	{
+		e->ignore();
+
+		return;
+	}
+
+	const int idx = e->mimeData()->data( FrameOnTape::mimeType() ).toInt();
+	const int step = d->m_frames.front()->width() + d->m_layout->spacing();
+	const int to = qBound( 1,
+		( e->position().toPoint().x() - d->m_layout->contentsMargins().left() ) / step + 1,
+		count() );
+
+	e->acceptProposedAction();
+
+	if( idx != to )
+		emit moveRequested( idx, to );
+}
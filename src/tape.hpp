@@ -26,12 +26,14 @@
 // Qt include.
 #include <QWidget>
 #include <QScopedPointer>
+#include <QVector>
 
 // GIF editor include.
 #include "frame.hpp"
 
 
 class FrameOnTape;
+class FrameModel;
 
 
 //
@@ -51,13 +53,19 @@ signals:
 	void clicked( int idx );
 	//! Current frame changed.
 	void currentFrameChanged( int idx );
-	//! Frame checked/unchecked.
-	void checkStateChanged( int idx, bool checked );
+	//! Frame \a idx was dragged to the place of frame \a to.
+	void moveRequested( int idx, int to );
 
 public:
 	Tape( QWidget * parent = nullptr );
 	~Tape() noexcept override;
 
+	//! \return Model of frames.
+	FrameModel * model() const;
+	//! Set model of frames, check boxes of frames show its checked state,
+	//! time ruler under frames shows its timeline.
+	void setModel( FrameModel * model );
+
 	//! \return Count of frames.
 	int count() const;
 	//! Add frame.
@@ -70,20 +78,38 @@ public:
 	void setCurrentFrame( int idx );
 	//! Clear.
 	void clear();
-	//! Remove unchecked frames.
+	//! Remove unchecked frames, the rest are renumbered and keep their thumbnails.
 	void removeUnchecked();
 	//! Remove frame.
 	void removeFrame( int idx );
+	//! Move \a count frames starting at \a first, so they start at \a to.
+	//! Frames are renumbered and keep their thumbnails.
+	void moveFrames( int first, int count, int to );
+	//! Replace frames with frames at positions \a order, positions may repeat.
+	//! Widgets of kept frames are reused with their thumbnails.
+	void rearrange( const QVector< qsizetype > & order );
+	//! Images were edited, thumbnails should be recreated.
+	void invalidate();
 	//! \return X coordinate of left border of the given frame.
 	int xOfFrame( int idx ) const;
 	//! \return Layout spacing.
 	int spacing() const;
 
+protected:
+	void paintEvent( QPaintEvent * e ) override;
+	void dragEnterEvent( QDragEnterEvent * e ) override;
+	void dragMoveEvent( QDragMoveEvent * e ) override;
+	void dropEvent( QDropEvent * e ) override;
+
 private slots:
 	//! Check/uncheck till end action activated.
 	void checkTillEnd( int idx, bool on );
+	//! Checked state of frames in model changed.
+	void modelCheckedChanged( int first, int last );
 
 private:
+	friend class TapePrivate;
+
 	Q_DISABLE_COPY( Tape )
 
 	QScopedPointer< TapePrivate > d;
@@ -67,11 +67,13 @@ public:
 
 class ViewPrivate {
 public:
-	ViewPrivate( const QGifLib::Gif & data, View * parent )
+	ViewPrivate( const Document & doc, View * parent )
 		:	m_tape( nullptr )
-		,	m_currentFrame( new Frame( { data, 0, true }, Frame::ResizeMode::FitToSize, parent ) )
+		,	m_currentFrame( new Frame( { doc, 0, true },
+				Frame::ResizeMode::FitToSize, parent ) )
 		,	m_crop( nullptr )
 		,	m_scroll( nullptr )
+		,	m_renderedIdx( 0 )
 		,	q( parent )
 	{
 	}
@@ -84,6 +86,10 @@ public:
 	CropFrame * m_crop;
 	//! Scroll area for tape.
 	ScrollArea * m_scroll;
+	//! Rendered image of the frame being selected.
+	QImage m_rendered;
+	//! Index of the frame with rendered image.
+	int m_renderedIdx;
 	//! Parent.
 	View * q;
 }; // class ViewPrivate
@@ -93,9 +99,9 @@ public:
 // View
 //
 
-View::View( const QGifLib::Gif & data, QWidget * parent )
+View::View( const Document & doc, QWidget * parent )
 	:	QWidget( parent )
-	,	d( new ViewPrivate( data, this ) )
+	,	d( new ViewPrivate( doc, this ) )
 {
 	QVBoxLayout * layout = new QVBoxLayout( this );
 	layout->setContentsMargins( 0, 0, 0, 0 );
@@ -169,13 +175,40 @@ View::stopCrop()
 	}
 }
 
+void
+View::showFrame( int idx, const QImage & img )
+{
+	d->m_rendered = img;
+	d->m_renderedIdx = idx;
+
+	d->m_tape->setCurrentFrame( idx );
+
+	d->m_rendered = QImage();
+	d->m_renderedIdx = 0;
+}
+
 void
 View::frameSelected( int idx )
 {
-	if( idx >= 1 && idx <= d->m_tape->count() )
+	if( idx == d->m_renderedIdx && d->m_rendered.size() == d->m_currentFrame->fitSize() )
+		d->m_currentFrame->setImage( idx - 1, d->m_rendered );
+	else if( idx >= 1 && idx <= d->m_tape->count() )
 	{
-		d->m_currentFrame->setImagePos( idx - 1 );
-		d->m_currentFrame->applyImage();
+		const auto fit = d->m_currentFrame->fitSize();
+		const auto preview = d->m_tape->frame( idx )->thumbnail();
+
+		// Thumbnail on tape is the cheapest image of frame, it's shown scaled up
+		// until the full quality image is rendered. Thumbnail rendered before
+		// crop has another aspect ratio and can't be used.
+		if( !preview.isNull() && !fit.isEmpty() &&
+			qAbs( (double) preview.width() / preview.height() -
+				(double) fit.width() / fit.height() ) < 0.05 )
+				d->m_currentFrame->setPreview( idx - 1, preview );
+		else
+		{
+			d->m_currentFrame->setImagePos( idx - 1 );
+			d->m_currentFrame->applyImage();
+		}
 	}
 	else
 		d->m_currentFrame->clearImage();
@@ -26,13 +26,11 @@
 // Qt include.
 #include <QWidget>
 #include <QScopedPointer>
+#include <QImage>
 
 // gif-editor include.
 #include "frame.hpp"
 
-// qgiflib include.
-#include <qgiflib.hpp>
-
 
 class Tape;
 
@@ -50,7 +48,7 @@ class View final
 	Q_OBJECT
 
 public:
-	explicit View( const QGifLib::Gif & data, QWidget * parent = nullptr );
+	explicit View( const Document & doc, QWidget * parent = nullptr );
 	~View() noexcept override;
 
 	//! \return Tape.
@@ -61,6 +59,9 @@ public:
 	//! \return Crop rectangle.
 	QRect cropRect() const;
 
+	//! Make frame \a idx current and show already rendered \a img of it.
+	void showFrame( int idx, const QImage & img );
+
 public slots:
 	//! Start crop.
 	void startCrop();